@@ -6,17 +6,18 @@
  *
  *  Description: Rcriture pour MPLAB X et CX8 C Compiler
  *
- *               Les caractres suivants sont gnrs et inscrit dans les cases de 0 -> 7
- *                   => 0          => 1          => 2         => 3         => 4
- *                   => 5         => 6         => 7
+ *               Les caractres 1  NB_GLYPHES sont des glyphes gnrs en CGRAM:
+ *                  tuile => 1     mine => 2     drapeau => 3
+ *                  mine explose => 4     drapeau mal plac => 5
+ *               Un glyphe n'est charg dans une des 8 cases de la CGRAM que la
+ *               premire fois qu'il est crit. Quand les 8 cases sont prises,
+ *               on remplace le glyphe utilis le moins rcemment, en ne
+ *               rcrivant que ses ranges qui changent. Un glyphe remplac
+ *               change aussi aux endroits o il est encore affich: ne pas
+ *               utiliser plus de 8 glyphes diffrents dans une mme image.
  *
- *               On peut utiliser LcdEcritCar() pour afficher ces caractres:
- *                  Ex: LcdEcritCar(0xE0)    affichera un a
- *
- *               On peut aussi utiliser LcdPutMess() et inclure ces caract`res dans la chane:
- *                  Ex: char szMess[] = "Voici un \x01."  affichera Voici un .
- *
- *               NOTE: Pour afficher un , on devra prendre LcdEcritCar() puisque \x00 est une fin de chane.
+ *               On peut utiliser LcdPutMess() et inclure ces caractres dans la chane:
+ *                  Ex: char szMess[] = "\x01\x02\x03"  affichera une tuile, une mine et un drapeau.
  *               										   -
  *                  INT ==> Intensite ajuste via un Potentiometre 10K
  *
@@ -29,6 +30,7 @@
  */
 
 #include "Lcd4Lignes.h"
+#include "veille.h"
 
 #define RS          PORTAbits.RA0 
 #define RW          PORTAbits.RA1 
@@ -60,21 +62,37 @@
 
 // Dfinition des variables globales
 
+unsigned int m_nbEcrituresLcd = 0;          // Compt par lcd_wrCom() et lcd_wrData() (voir mesure.c)
+
 // Variable pour la gnrations de certains caractres en CGRAM
-// On aura dans l'ordrer (8 octets par caractre):        
+// On aura dans l'ordre (8 octets par caractre) les glyphes 1  NB_GLYPHES:
+// tuile, mine, drapeau, mine explose, drapeau mal plac
 
-char matCGRAM[8][8] =
+#define NB_GLYPHES          5               // Glyphes dfinis dans matGlyphes
+#define NB_CASES_CGRAM      8               // Cases de la CGRAM
+#define CODE_CGRAM          0x08            // Les codes 0x08  0x0F affichent les cases 0  7 (0x00 serait la fin d'une chane)
+#define AUCUN               0xFF            // Case vide ou glyphe pas charg
+
+const char matGlyphes[NB_GLYPHES][8] =
 {
-    {8,4,4,0x0A,0x11,0x1F,0x11,0},            // 
     {0x1F,0x1B,0x11,0x11,0x11,0x11,0x1B,0x1F},        // caractre reprsentant une tuile
     {0x00,0x15,0x0E,0x1F,0x1F,0x0E,0x15,0x00},        // caractre reprsentant une mine
     {0x08,0x0C,0x0E,0x0F,0x0C,0x08,0x08,0x1C},        // caractre reprsentant un drapeau
-    {0x04,0x04,0x04,0x04,0x0E,0x0E,0x1B,0x11}, // caractre reprsentant le canon (ancien lab)
-    {4,0x0A,0x0E,0x11,0x1F,0x10,0x0E,0},    // 
-    {8,4,0x0E,01,0x0F,0x11,0x0F,0},         //     
-    {4,0x0A,0x0E,1,0x0F,0x11,0x0F,0},       // 
+    {0x1F,0x0A,0x11,0x00,0x00,0x11,0x0A,0x1F},        // mine en ngatif: celle qui a explos
+    {0x19,0x0E,0x0E,0x0F,0x1D,0x08,0x08,0x1C},        // drapeau barr: pas de mine dessous
 };
 
+static unsigned char m_glypheCase[NB_CASES_CGRAM];  // Glyphe charg dans chaque case, AUCUN si la case est vide
+static unsigned char m_caseGlyphe[NB_GLYPHES];      // Case de chaque glyphe, AUCUN s'il n'est pas charg
+static unsigned char m_ordreCases[NB_CASES_CGRAM];  // Cases de la plus rcemment utilise  la moins rcemment utilise
+
+// Le Timer1 (Fosc/4 = 250 kHz, 4 us par coup) est dmarr par le programme
+// principal ds le reset. Le temps coul depuis compte dans les 40 ms de
+// mise sous tension du LCD: le programme peut prparer sa premire image
+// avant d'appeler lcd_init(). On lit veille_cycles() plutt que TMR1: le
+// Timer1 a pu dborder (262 ms) pendant cette prparation.
+#define DELAI_MISE_SOUS_TENSION 10000UL     // 40 ms en cycles de veille_cycles()
+
 // Prototypes des fonctions internes
 
 static unsigned char lcd_busy(void);
@@ -84,6 +102,8 @@ static unsigned char lcd_lireDonnees(void);
 static void lcd_ecrireDonnees(unsigned char cDonnee);
 static void lcd_resetSequence(void);
 static void lcd_initCGRam(void);
+static unsigned char lcd_codeGlyphe(unsigned char glyphe);
+static void lcd_chargeGlyphe(unsigned char noCase, unsigned char glyphe);
 static void lcd_strobeEnableBit(void);
 
 // Cette fonction permettra de lire le port de donnes que
@@ -155,8 +175,9 @@ static unsigned char lcd_busy(void)
 
 static unsigned char lcd_wrCom(unsigned char commande)
 {
-    lcd_busy();
-
+    // Pas de lcd_busy() ici: l'criture prcdente se termine dj par une
+    // attente du busy flag.
+    m_nbEcrituresLcd++;
     MODE_OUT;
     __delay_us(2);
      
@@ -169,7 +190,6 @@ static unsigned char lcd_wrCom(unsigned char commande)
 
     lcd_ecrireDonnees(commande);           // Les 4 bits infrieurs
     lcd_strobeEnableBit();
-    __delay_us(40);     	// Temps Max d'excution d'une commande
 
     if ((commande == VIDE_ECRAN) || commande == HOME_CURSEUR)
         __delay_ms(2);
@@ -187,8 +207,8 @@ static unsigned char lcd_wrCom(unsigned char commande)
  
 static unsigned char lcd_wrData(unsigned char caractere)
 {
-    lcd_busy();                             // Vrifie si affichage prt  recevoir  le caractre
-    MODE_OUT;
+    m_nbEcrituresLcd++;
+    MODE_OUT;                               // L'criture prcdente a dj attendu le busy flag
     __delay_us(2);
 
     RS = 1;                // RS = 1
@@ -225,7 +245,10 @@ static void lcd_resetSequence(void)
 
     MODE_OUT;
 
-    __delay_ms(40);
+    if (T1CONbits.TMR1ON)   // Le Timer1 compte depuis le reset: on attend seulement le reste des 40 ms
+        while (veille_cycles() < DELAI_MISE_SOUS_TENSION);
+    else
+        __delay_ms(40);
     RS = 0;                 // RS = 0
     RW = 0;                 // RW = 0
 
@@ -259,12 +282,13 @@ void lcd_init(void)
 {    
     //TRISB = TRISB & 0xEF;       // B4 en out
     lcd_resetSequence();            // Squence pour mettre en 4 bits
+    lcd_busy();                     // Seule attente avant une criture, les suivantes attendent aprs
     lcd_wrCom(INIT_DISPLAY);        // System set: 4 bits, 2 lignes, 5x7
     lcd_wrCom(CURSEUR_ON);          // Display, curseur et blink on
     lcd_wrCom(VIDE_ECRAN);          // Efface cran et initialise curseur
     lcd_wrCom(CURSEUR_MOVE);        // Position du curseur incrmente sans scroll
     lcd_wrCom(SET_RAM_ADR);         // Adresse de la position d'criture a zero
-    lcd_initCGRam();
+    lcd_initCGRam();                // Rien n'est charg: chaque glyphe le sera  sa premire criture
 }
 
 /*
@@ -360,6 +384,8 @@ void lcd_ecritChar(unsigned char car)
 {
     unsigned char posRam;
 
+    if (car >= 1 && car <= NB_GLYPHES)
+        car = lcd_codeGlyphe(car);          // Charge le glyphe au besoin
     posRam = lcd_wrData(car);
     switch(posRam)
     {
@@ -414,17 +440,90 @@ void lcd_montreCurseur(void)
     lcd_wrCom(CURSEUR_ON);
 }
 
-static void lcd_initCGRam(void)        // pMatCGRAM
+/*
+    Entree:     Rien
+    Sortie:     Rien
+    Utilite:    Marque toutes les cases de la CGRAM comme vides. Le contenu
+                de la CGRAM est indfini  la mise sous tension.
+*/
+
+static void lcd_initCGRam(void)
 {
-    char i,j;
-    
-    lcd_wrCom(SET_CGRAM_ADR);
-    for(i=0;i<8;i++)
+    unsigned char i;
+
+    for(i=0;i<NB_CASES_CGRAM;i++)
+    {
+        m_glypheCase[i] = AUCUN;
+        m_ordreCases[i] = i;
+    }
+    for(i=0;i<NB_GLYPHES;i++)
+        m_caseGlyphe[i] = AUCUN;
+}
+
+/*
+    Entree:     Numro du glyphe (1  NB_GLYPHES)
+    Sortie:     Code  crire en DDRAM pour l'afficher
+    Utilite:    Trouve la case du glyphe, le charge  la place du glyphe
+                utilis le moins rcemment s'il n'est pas en CGRAM, et met
+                sa case en tte de l'ordre d'utilisation
+*/
+
+static unsigned char lcd_codeGlyphe(unsigned char glyphe)
+{
+    unsigned char noCase = m_caseGlyphe[glyphe - 1];
+    unsigned char i;
+
+    if (noCase == AUCUN)
     {
-        for(j=0;j<8;j++)
-            lcd_wrData(matCGRAM[i][j]);
+        noCase = m_ordreCases[NB_CASES_CGRAM - 1];
+        lcd_chargeGlyphe(noCase, glyphe);
     }
-    lcd_curseurHome();
+    if (m_ordreCases[0] != noCase)          // Le plus souvent, le mme glyphe qu'au caractre prcdent
+    {
+        for(i = 1; m_ordreCases[i] != noCase; i++);
+        for(; i > 0; i--)
+            m_ordreCases[i] = m_ordreCases[i - 1];
+        m_ordreCases[0] = noCase;
+    }
+    return(CODE_CGRAM | noCase);
+}
+
+/*
+    Entree:     Case de la CGRAM et glyphe  y mettre
+    Sortie:     Rien
+    Utilite:    crit en CGRAM seulement les ranges qui diffrent du glyphe
+                dj dans la case, puis remet l'adresse d'criture en DDRAM
+                o elle tait
+*/
+
+static void lcd_chargeGlyphe(unsigned char noCase, unsigned char glyphe)
+{
+    unsigned char ancien = m_glypheCase[noCase];
+    unsigned char adresse = lcd_busy();     // Position d'criture en DDRAM
+    bool suite = false;                     // Vrai si la range prcdente vient d'tre crite
+    bool ecrit = false;
+    unsigned char j;
+
+    for(j=0;j<8;j++)
+    {
+        if (ancien == AUCUN || matGlyphes[ancien - 1][j] != matGlyphes[glyphe - 1][j])
+        {
+            if (!suite)                     // L'adresse CGRAM avance seule d'une range  l'autre
+                lcd_wrCom(SET_CGRAM_ADR | (noCase * 8 + j));
+            lcd_wrData(matGlyphes[glyphe - 1][j]);
+            suite = true;
+            ecrit = true;
+        }
+        else
+            suite = false;
+    }
+    if (ecrit)
+        lcd_wrCom(SET_RAM_ADR | adresse);
+
+    if (ancien != AUCUN)
+        m_caseGlyphe[ancien - 1] = AUCUN;
+    m_glypheCase[noCase] = glyphe;
+    m_caseGlyphe[glyphe - 1] = noCase;
 }
 
 
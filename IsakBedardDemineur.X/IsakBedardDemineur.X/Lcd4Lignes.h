@@ -11,18 +11,24 @@
 
 /**   
  *  Vous avez aussi les caratres suivants qui ne sont pas dans le standard ASCII
- *   = 0          = 1          = 2         = 3         = 4    
- *   = 5          = 6          = 7
+ *  tuile = 1     mine = 2      drapeau = 3
+ *  mine explose = 4     drapeau mal plac = 5
+ *  Ils sont chargs en CGRAM  leur premire criture (au plus 8 diffrents
+ *  par image). Les codes 0x08  0x0F sont rservs  ces glyphes.
  * 
- *  Exemple: lcdPutMess("\1t\1");  ==> t
+ *  Exemple: lcdPutMess("\1\3\1");  ==> tuile, drapeau, tuile
  */
 
 #include <xc.h>
 #include <stdbool.h>  // pour l'utilisation du type bool
 #define _XTAL_FREQ 1000000 //Constante utilise par __delay_ms(x). Doit = frq interne du uC
 
+extern unsigned int m_nbEcrituresLcd; //octets (commandes et caractres) crits au LCD depuis le reset
+
 /**
  * @brief Fonction d'initialisation. Elle doit tre appele avant de pouvoit utiliser les autres.
+ * Si le Timer1 tourne depuis le reset, le dlai de mise sous tension de 40 ms
+ * est compt  partir du reset plutt qu' partir de l'appel.
  */
 void lcd_init(void);
 
@@ -0,0 +1,444 @@
+/**
+ * @file   commande.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Traitement des commandes reues par le port srie.
+ *
+ * Pour les comptitions, tous les appareils doivent jouer le mme champ de
+ * mines. L'hte envoie le champ compact (1 bit par case) et l'appareil le
+ * charge directement dans m_tabMines, sans passer par hasard(). Les joueurs
+ * automatiques jouent par les mmes fonctions que le joystick (joue(),
+ * metOuEnleveDrapeau()). Le format des commandes est dcrit dans commande.h.
+ * Les caractres sont reus par interruption (serie.c): une commande peut
+ * arriver pendant un affichage sans rien perdre.
+ */
+
+#include <xc.h>
+#include <conio.h>
+#include "Lcd4Lignes.h"
+#include "serie.h"
+#include "demineur.h"
+#include "entrees.h"
+#include "stats.h"
+#include "masque.h"
+#include "hasard.h"
+#include "mesure.h"
+#include "veille.h"
+#include "moniteur.h"
+#include "commande.h"
+
+#define CMD_CHARGE 'L' //chargement d'un champ de mines compact
+#define CMD_ENREGISTRE 'E' //dbut de l'enregistrement des entres
+#define CMD_FIN 'F' //fin de l'enregistrement des entres
+#define CMD_REJOUE 'R' //rejeu d'un enregistrement
+#define CMD_STATS 'S' //envoi du journal des parties (EEPROM)
+#define CMD_DEVOILE 'D' //clic sur une case
+#define CMD_DRAPEAU 'M' //drapeau sur une case
+#define CMD_VUE 'V' //envoi de m_tabVue
+#define CMD_LOT 'B' //suite de coups, un seul affichage
+#define CMD_MESURE 'P' //mesures de performance
+#define CMD_VEILLE 'W' //temps actif et temps en veille
+#define CMD_ECHEANCE 'T' //chance du moniteur
+#define CMD_MONITEUR 'J' //envoi des compteurs du moniteur
+#define CMD_GENERATION 'G' //temps de gnration des champs sans devinette
+#define REFUS 'X' //rponse  une commande refuse pendant un enregistrement
+
+static bool commande_charge(void);
+static void commande_enregistre(void);
+static bool commande_rejoue(void);
+static bool commande_joueUn(char action);
+static bool commande_lot(void);
+static char commande_action(char action, uint8_t x, uint8_t y);
+static bool commande_litCase(uint8_t* x, uint8_t* y);
+static void commande_envoieVue(void);
+static void commande_mesure(void);
+static void commande_generation(void);
+static void commande_echeance(void);
+static void commande_envoieHex(unsigned int valeur);
+static void commande_refuse(char commande);
+static void commande_saute(unsigned char nbOctets);
+
+/*
+ * @brief Lit l'octet de commande et appelle le traitement correspondant.
+ * Les commandes inconnues sont ignores. Pendant un enregistrement, seule
+ * CMD_FIN est excute: voir commande_refuse().
+ * @param rien
+ * @return vrai si la commande a recommenc la partie
+ */
+bool commande_traite(void)
+{
+    char c = getch();
+
+    if (entrees_enregistreEnCours() && c != CMD_FIN) {
+        commande_refuse(c);
+        return false;
+    }
+    switch (c) {
+        case CMD_CHARGE:
+            return commande_charge();
+        case CMD_ENREGISTRE:
+            commande_enregistre();
+            return true;
+        case CMD_FIN:
+            entrees_arreteEnregistrement();
+            break;
+        case CMD_REJOUE:
+            return commande_rejoue();
+        case CMD_STATS:
+            stats_envoie();
+            break;
+        case CMD_DEVOILE:
+        case CMD_DRAPEAU:
+            return commande_joueUn(c);
+        case CMD_LOT:
+            return commande_lot();
+        case CMD_MESURE:
+            commande_mesure();
+            return true;
+        case CMD_GENERATION:
+            commande_generation();
+            return true;
+        case CMD_VEILLE:
+            veille_envoie();
+            break;
+        case CMD_ECHEANCE:
+            commande_echeance();
+            break;
+        case CMD_MONITEUR:
+            moniteur_envoie();
+            break;
+        case CMD_VUE:
+            commande_envoieVue();
+            break;
+    }
+    return false;
+}
+
+/*
+ * @brief Reoit un champ compact et son CRC-8, le place dans m_tabMines,
+ * calcule les chiffres avec metToucheCombien() et recommence la partie avec
+ * ce champ. Sa premire case vide, dans l'ordre du masque, est dvoile
+ * comme premier coup: c'est la case de dpart des champs sans devinette de
+ * hote/generation.c. Rpond avec le hachage du champ charg.
+ * Le nombre de mines de m_partie devient celui du champ charg.
+ * @param rien
+ * @return vrai si le champ a t charg, faux si le CRC-8 tait mauvais (la
+ * partie en cours continue)
+ */
+static bool commande_charge(void)
+{
+    unsigned char masque[NB_OCTETS_MASQUE]; //champ reu, 1 bit par case
+    uint8_t x = 1, y = 1; //case de dpart
+
+    for (char i = 0; i < NB_OCTETS_MASQUE; i++)
+        masque[i] = getch(); //l'hte envoie tout d'un bloc, 10 octets = 11 ms  9600 bauds
+    if ((unsigned char) getch() != masque_crc8(masque, NB_OCTETS_MASQUE)) {
+        serie_envoieTexte("ERR\r\n");
+        return false;
+    }
+
+    m_partie.nbMines = masque_decompacte(masque);
+    m_partie.garanti = true; //champ impos par l'hte: le mode sans devinette ne s'applique pas
+    stats_debutPartie(m_partie.nbMines);
+    metToucheCombien(); //les chiffres sont dduits du champ, aucun hasard
+    initTabVue();
+    while (y <= NB_LIGNE && m_tabMines[y - 1][x - 1] != ' ') { //premire case vide
+        x++;
+        if (x > NB_COL) {
+            x = 1;
+            y++;
+        }
+    }
+    if (y <= NB_LIGNE) //sans case vide, le joueur commence comme dans une partie ordinaire
+        enleveTuilesAutour(x, y);
+    afficheTabVue();
+
+    serie_envoieTexte("OK ");
+    commande_envoieHex(masque_hacheChamp()); //l'hte vrifie que l'appareil joue bien le champ envoy
+    serie_envoieTexte("\r\n");
+    return true;
+}
+
+/*
+ * @brief Choisit un nouveau germe pour hasard(), commence l'enregistrement des
+ * entres et recommence la partie. L'entte de l'enregistrement contient
+ * tout ce qu'il faut pour regnrer le mme champ.
+ * @param rien
+ * @return rien
+ */
+static void commande_enregistre(void)
+{
+    unsigned int germe = TMR1; //mme source de hasard qu'au dmarrage
+
+    hasard_germe(germe);
+    entrees_enregistre(germe, m_partie.nbMines, m_sansDevinette);
+    nouvellePartie();
+}
+
+/*
+ * @brief Reoit l'entte d'un enregistrement (germe, nombre de mines, mode
+ * sans devinette), regnre le mme champ et passe les entres en rejeu.
+ * Un nombre de mines plus grand que le champ est refus: rempliMines() ne
+ * finirait jamais.
+ * @param rien
+ * @return vrai si le rejeu a commenc, faux si l'entte a t refuse
+ */
+static bool commande_rejoue(void)
+{
+    unsigned int germe = (unsigned int) getch() << 8;
+    uint8_t nbMines;
+    bool sansDevinette;
+
+    germe |= (unsigned char) getch();
+    nbMines = getch();
+    sansDevinette = getch() != 0;
+    if (nbMines > NB_CASES) {
+        serie_envoieTexte("ERR\r\n");
+        return false;
+    }
+    m_partie.nbMines = nbMines;
+    m_sansDevinette = sansDevinette;
+    lcd_init(); //CGRAM vide, comme au dbut de hote/rejeu: le rejeu crit les mmes octets au LCD
+    mesure_debutRejeu(); //le rapport compte aussi la nouvelle partie
+    hasard_germe(germe);
+    entrees_rejoue();
+    nouvellePartie();
+    return true;
+}
+
+/*
+ * @brief Reoit une case et y joue un coup ('D' ou 'M'), puis actualise le
+ * LCD et rpond avec le rsultat.
+ * @param char action CMD_DEVOILE ou CMD_DRAPEAU
+ * @return vrai si une nouvelle partie a t commence
+ */
+static bool commande_joueUn(char action)
+{
+    uint8_t x, y;
+    char resultat;
+
+    if (!commande_litCase(&x, &y)) {
+        serie_envoieTexte("ERR\r\n");
+        return false;
+    }
+    resultat = commande_action(action, x, y);
+    afficheTabVue();
+    putch(resultat);
+    return resultat != PARTIE_EN_COURS;
+}
+
+/*
+ * @brief Joue une suite de coups. Les coups modifient seulement m_tabVue et
+ * m_tabMines; le LCD est crit une seule fois  la fin, puis la vue est
+ * renvoye  l'hte. Contrle de flux: la rponse d'un coup est envoye
+ * avant de lire le suivant, et l'hte attend cette rponse avant d'envoyer
+ * le coup suivant. Un coup qui termine la partie appelle preparePartie()
+ * (des dizaines de ms, bien plus en mode sans devinette), alors que le
+ * tampon de rception (32 octets) est plein en 33 ms  9600 bauds: sans
+ * cette attente, les octets en trop seraient perdus et la suite du lot lue
+ * en dcalage. Il n'y a ainsi jamais plus d'un coup (3 octets) en attente.
+ * @param rien
+ * @return vrai si au moins une nouvelle partie a t commence
+ */
+static bool commande_lot(void)
+{
+    uint8_t nbCoups = getch();
+    uint8_t x, y;
+    char action;
+    char resultat;
+    bool recommence = false;
+
+    while (nbCoups > 0) {
+        action = getch();
+        if (commande_litCase(&x, &y) && (action == CMD_DEVOILE || action == CMD_DRAPEAU)) {
+            resultat = commande_action(action, x, y);
+            if (resultat != PARTIE_EN_COURS)
+                recommence = true;
+        } else
+            resultat = 'X';
+        putch(resultat); //l'hte peut envoyer le coup suivant
+        nbCoups--;
+    }
+    afficheTabVue(); //une seule criture du LCD pour tout le lot
+    commande_envoieVue();
+    return recommence;
+}
+
+/*
+ * @brief Joue un coup sans toucher au LCD. Une partie termine est aussitt
+ * remplace par une nouvelle: l'hte n'a pas de bouton pour sortir de
+ * l'affichage des mines.
+ * @param char action CMD_DEVOILE ou CMD_DRAPEAU
+ * @param uint8_t x, uint8_t y La case, dj valide
+ * @return PARTIE_EN_COURS, PARTIE_GAGNEE ou PARTIE_PERDUE
+ */
+static char commande_action(char action, uint8_t x, uint8_t y)
+{
+    char resultat = PARTIE_EN_COURS;
+
+    if (action == CMD_DEVOILE) {
+        resultat = joue(x, y);
+        if (resultat != PARTIE_EN_COURS)
+            preparePartie();
+    } else
+        metOuEnleveDrapeau(x, y);
+    return resultat;
+}
+
+/*
+ * @brief Reoit la colonne et la ligne d'une case (positions du LCD, 
+ * partir de 1) et vrifie qu'elle est dans le champ.
+ * @param uint8_t* x, uint8_t* y Reoivent la colonne et la ligne
+ * @return vrai si la case est valide
+ */
+static bool commande_litCase(uint8_t* x, uint8_t* y)
+{
+    *x = getch();
+    *y = getch();
+    return *x >= 1 && *x <= NB_COL && *y >= 1 && *y <= NB_LIGNE;
+}
+
+/*
+ * @brief Envoie m_tabVue ligne par ligne, sans les '\0' de fin de ligne.
+ * @param rien
+ * @return rien
+ */
+static void commande_envoieVue(void)
+{
+    for (char i = 0; i < NB_LIGNE; i++)
+        for (char j = 0; j < NB_COL; j++)
+            putch(m_tabVue[i][j]);
+}
+
+/*
+ * @brief Reoit le mode et la rfrence ventuelle, fait les mesures puis
+ * recommence la partie, que les mesures ont remplace.
+ * @param rien
+ * @return rien
+ */
+static void commande_mesure(void)
+{
+    unsigned long reference[NB_METRIQUES]; //p50 de rfrence de chaque mtrique
+    unsigned char seuil = 0;
+
+    if (getch() == 0)
+        mesure_execute(0, 0);
+    else {
+        seuil = getch();
+        for (char m = 0; m < NB_METRIQUES; m++) {
+            reference[m] = 0;
+            for (char i = 0; i < 4; i++)
+                reference[m] = (reference[m] << 8) | (unsigned char) getch();
+        }
+        mesure_execute(reference, seuil);
+    }
+    hasard_germe(TMR1); //les mesures ont utilis des germes fixes
+    nouvellePartie();
+}
+
+/*
+ * @brief Reoit un nombre de mines et mesure la gnration des champs sans
+ * devinette  cette densit, puis recommence la partie.
+ * @param rien
+ * @return rien
+ */
+static void commande_generation(void)
+{
+    uint8_t nb = getch();
+
+    if (nb == 0 || nb >= NB_CASES) //il faut au moins une case vide pour commencer
+        serie_envoieTexte("ERR\r\n");
+    else
+        mesure_generation(nb);
+    hasard_germe(TMR1);
+    nouvellePartie();
+}
+
+/*
+ * @brief Reoit la nouvelle chance du moniteur, en ms. Une chance de 0
+ * ferait de chaque tick un dpassement: elle est refuse.
+ * @param rien
+ * @return rien
+ */
+static void commande_echeance(void)
+{
+    unsigned char ms = getch();
+
+    if (ms == 0)
+        serie_envoieTexte("ERR\r\n");
+    else
+        moniteur_echeance(ms);
+}
+
+/*
+ * @brief Refuse une commande reue pendant un enregistrement. Seules les
+ * entres lues par entrees_lit() doivent changer la partie enregistre, sinon
+ * le rejeu ne la referait pas. Les donnes de la commande sont lues sans rien
+ * faire et sa rponse est remplace par REFUS (un par coup pour CMD_LOT).
+ * REFUS est envoy entre deux paires de l'enregistrement et ne peut pas tre
+ * confondu avec un tat (toujours < 0x40) ni avec la fin ('F').
+ * @param char commande L'octet de commande reu
+ * @return rien
+ */
+static void commande_refuse(char commande)
+{
+    switch (commande) {
+        case CMD_CHARGE:
+            commande_saute(NB_OCTETS_MASQUE + 1); //masque et CRC-8
+            break;
+        case CMD_REJOUE:
+            commande_saute(4); //germe, nombre de mines et mode
+            break;
+        case CMD_DEVOILE:
+        case CMD_DRAPEAU:
+            commande_saute(2); //colonne et ligne
+            break;
+        case CMD_ECHEANCE:
+        case CMD_GENERATION:
+            commande_saute(1);
+            break;
+        case CMD_MESURE:
+            if (getch() != 0) //mode comparaison: seuil et rfrences
+                commande_saute(1 + 4 * NB_METRIQUES);
+            break;
+        case CMD_LOT:
+            for (uint8_t nbCoups = getch(); nbCoups > 0; nbCoups--) {
+                commande_saute(3); //action, colonne et ligne
+                putch(REFUS);
+            }
+            return;
+        case CMD_ENREGISTRE:
+        case CMD_STATS:
+        case CMD_VUE:
+        case CMD_VEILLE:
+        case CMD_MONITEUR:
+            break; //aucune donne
+        default:
+            return; //commande inconnue: ignore, comme hors enregistrement
+    }
+    putch(REFUS);
+}
+
+/*
+ * @brief Lit et oublie des octets reus.
+ * @param unsigned char nbOctets Le nombre d'octets
+ * @return rien
+ */
+static void commande_saute(unsigned char nbOctets)
+{
+    while (nbOctets > 0) {
+        getch();
+        nbOctets--;
+    }
+}
+
+/*
+ * @brief Envoie une valeur de 16 bits en 4 chiffres hexadcimaux.
+ * @param valeur La valeur  envoyer
+ * @return rien
+ */
+static void commande_envoieHex(unsigned int valeur)
+{
+    for (signed char decalage = 12; decalage >= 0; decalage -= 4)
+        putch("0123456789ABCDEF"[(valeur >> decalage) & 0x0F]);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file   commande.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Commandes reues par le port srie (chargement de champs de mines
+ * pour les tournois, partie joue  distance).
+ *
+ * Commandes reconnues (un octet de commande suivi de ses donnes):
+ *  - 'L' + NB_OCTETS_MASQUE octets de masque + 1 octet de CRC-8:
+ *    charge le champ de mines. La case (ligne, colonne) est le bit
+ *    (k % 8) de l'octet k / 8, o k = ligne * NB_COL + colonne.
+ *    Le CRC-8 (polynme 0x07, valeur initiale 0) est calcul sur le masque.
+ *    La premire case vide du champ (dans l'ordre du masque) est dvoile
+ *    avec ses voisines: un champ valid par hote/generation.c se rsout
+ *    alors sans deviner. hote/generation.c -o crit ses champs dans ce
+ *    format, une trame de 2 + NB_OCTETS_MASQUE octets par champ.
+ *    Rponse: "OK hhhh\r\n", o hhhh est le hachage CRC-16 (CCITT, valeur
+ *    initiale 0xFFFF) du champ rellement charg, ou "ERR\r\n" si le CRC-8
+ *    reu est mauvais (le champ courant n'est alors pas modifi).
+ *  - 'E': choisit un nouveau germe, recommence la partie et enregistre les
+ *    entres (format dans entrees.h).
+ *  - 'F': termine l'enregistrement.
+ *  - 'R' + germe (2 octets, poids fort d'abord) + nombre de mines (0 
+ *    NB_CASES) + mode sans devinette (0 ou 1): recommence la mme partie et
+ *    rejoue les entres envoyes par l'hte. Rponse "ERR\r\n" si le nombre
+ *    de mines est trop grand (la partie en cours continue). Le LCD est
+ *    rinitialis avant la nouvelle partie.  la fin du rejeu, l'appareil
+ *    envoie un rapport en JSON (format dans mesure.h).
+ *  - 'S': envoie les 256 octets de l'EEPROM (journal des parties, format
+ *    dans stats.h).
+ *  - 'D' + colonne (1  NB_COL) + ligne (1  NB_LIGNE): dvoile la case,
+ *    comme le bouton du joystick. Rponse: 'C' (partie en cours), 'G'
+ *    (gagne) ou 'P' (perdue). Une partie termine est aussitt remplace
+ *    par une nouvelle, sans attendre le bouton.
+ *  - 'M' + colonne + ligne: met ou enlve un drapeau, comme SW0. Rponse:
+ *    'C'.
+ *  - 'V': envoie m_tabVue, NB_LIGNE * NB_COL octets ligne par ligne (TUILE,
+ *    DRAPEAU, espace ou chiffre ASCII).
+ *  - 'B' + n, puis n coups de 3 octets (action 'D' ou 'M', colonne, ligne):
+ *    joue les n coups  la suite. Rponse: un caractre par coup, envoy
+ *    ds que le coup est jou ('C', 'G', 'P', ou 'X' pour un coup invalide),
+ *    puis m_tabVue comme pour 'V'. L'hte doit attendre la rponse d'un
+ *    coup avant d'envoyer le suivant: une partie termine est remplace
+ *    pendant le lot, ce qui peut prendre plus de temps qu'il n'en faut pour
+ *    remplir le tampon de rception. Aprs 'G' ou 'P', les coups suivants
+ *    sont jous dans la nouvelle partie. Le LCD n'est actualis qu'une fois.
+ *  - 'P' + mode (0 = mesure, 1 = comparaison), suivi en mode comparaison
+ *    d'un seuil en pourcentage et de NB_METRIQUES rfrences de 4 octets
+ *    (poids fort d'abord): mesure les performances et envoie le rsultat en
+ *    JSON (format dans mesure.h). La partie en cours est recommence.
+ *  - 'W': envoie le temps actif et le temps en veille du CPU depuis le
+ *    dmarrage (format dans veille.h).
+ *  - 'T' + chance en ms (1  255): change l'chance d'un tick et remet
+ *     zro les compteurs du moniteur. Rponse "ERR\r\n" pour 0 (rien ne
+ *    change), aucune sinon.
+ *  - 'J': envoie les dpassements d'chance et l'histogramme des carts
+ *    entre les ticks (format dans moniteur.h).
+ *  - 'G' + nombre de mines (1  NB_CASES - 1): gnre NB_ESSAIS champs sans
+ *    devinette  cette densit et envoie le temps de gnration en JSON
+ *    (format dans mesure.h). La partie en cours est recommence.
+ * Pour 'D' et 'M', une position hors du champ donne la rponse "ERR\r\n".
+ * Pendant un enregistrement (entre 'E' et 'F'), toutes les commandes sauf
+ * 'F' sont refuses: leurs donnes sont lues et ignores, et l'appareil
+ * rpond seulement 'X' (un 'X' par coup pour 'B'). La partie enregistre ne
+ * change ainsi que par les entres de la carte, et les rponses ne se
+ * mlent pas aux paires de l'enregistrement.
+ * Un hte peut ainsi jouer des parties compltes sans toucher  la carte.
+ * hote/serveur.c rpond aux commandes de jeu ('L', 'D', 'M', 'V', 'B') de
+ * la mme faon, pour des milliers de parties  la fois sur l'ordinateur.
+ */
+
+#ifndef COMMANDE_H
+#define	COMMANDE_H
+
+#include <stdbool.h>  // pour l'utilisation du type bool
+
+/**
+ * @brief Lit et excute la commande reue sur le port srie.  appeler
+ * seulement si kbhit() indique qu'un caractre est arriv. Le nombre de
+ * mines de m_partie est mis  jour si un champ est charg ou une partie
+ * rejoue.
+ * @return vrai si la commande a recommenc la partie (le curseur doit tre
+ * remis au centre)
+ */
+bool commande_traite(void);
+
+#endif	/* COMMANDE_H */
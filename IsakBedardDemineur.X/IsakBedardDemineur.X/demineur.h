@@ -0,0 +1,88 @@
+/**
+ * @file   demineur.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Constantes et tableaux du jeu partags entre partie.c, regles.c et
+ * les autres modules du dmineur (solveur, etc.).
+ */
+
+#ifndef DEMINEUR_H
+#define	DEMINEUR_H
+
+#include <stdbool.h>  // pour l'utilisation du type bool
+#include <stdint.h>  // pour les types de taille fixe (uint8_t)
+
+/*
+ * Le PIC joue toujours sur le LCD 4x20. hote/Makefile compile aussi les
+ * rgles pour d'autres tailles (-DNB_LIGNE=16 -DNB_COL=30) afin de comparer
+ * les noyaux. Les indices sont des char: au plus 255 lignes et colonnes.
+ * Au-del de 255 cases, seuls metToucheCombien() et enleveTuilesAutour()
+ * restent justes (gagne() et le solveur comptent les cases sur 8 bits).
+ */
+#ifndef NB_LIGNE
+#define NB_LIGNE 4  //afficheur LCD 4x20
+#endif
+#ifndef NB_COL
+#define NB_COL 20
+#endif
+#define NB_CASES (NB_LIGNE * NB_COL) //nombre de cases du champ
+#define TUILE 1 //caractre cgram d'une tuile
+#define MINE 2 //caractre cgram d'une mine
+#define DRAPEAU 3 //caractre cgram d'un drapeau
+#define MINE_EXPLOSEE 4 //caractre cgram de la mine dvoile par le joueur
+#define DRAPEAU_FAUX 5 //caractre cgram d'un drapeau sans mine dessous
+#define VOISIN_MIN(v) ((v) == 0 ? 0 : (v) - 1) //premire ligne (colonne) voisine de v sans dpasser du LCD
+#define VOISIN_MAX(v, nb) ((v) == (nb) - 1 ? (v) : (v) + 1) //dernire ligne (colonne) voisine de v, nb = NB_LIGNE ou NB_COL
+#define NB_OCTETS_MASQUE ((NB_LIGNE * NB_COL + 7) / 8) //taille d'un champ de mines compact (1 bit par case)
+#define X_DEPART 10 //position du curseur au dbut, environ au centre du LCD
+#define Y_DEPART 2
+#define NB_MINES_DEPART 9 //nombre de mines de la premire partie, si l'EEPROM est vide
+#define PARTIE_EN_COURS 'C' //rsultats de joue(), aussi envoys tels quels par le port srie
+#define PARTIE_GAGNEE 'G'
+#define PARTIE_PERDUE 'P'
+
+/*
+ * L'tat du jeu est global: le PIC n'a qu'une partie. Sur l'ordinateur,
+ * plusieurs fils d'excution jouent chacun la leur (hote/Makefile dfinit
+ * LOCAL_FIL comme _Thread_local).
+ */
+#ifndef LOCAL_FIL
+#define LOCAL_FIL
+#endif
+
+/*
+ * tat de la partie. Les positions sont celles du LCD ( partir de 1). Tous
+ * les champs tiennent sur 8 bits: le PIC les traite en une instruction.
+ */
+typedef struct {
+    uint8_t x; //colonne du curseur, 1  NB_COL
+    uint8_t y; //ligne du curseur, 1  NB_LIGNE
+    uint8_t nbMines; //nombre de mines de la partie. Augmente de 1 lorsqu'on gagne
+    bool garanti; //faux si le mode sans devinette n'a pas trouv de champ qui se rsout sans deviner
+} Partie;
+
+extern LOCAL_FIL Partie m_partie; //la partie en cours
+extern LOCAL_FIL char m_tabVue[NB_LIGNE][NB_COL + 1]; //Tableau des caractres affichs au LCD
+extern LOCAL_FIL char m_tabMines[NB_LIGNE][NB_COL + 1]; //Tableau contenant les mines, les espaces et les chiffres
+extern LOCAL_FIL bool m_sansDevinette; //vrai si les champs gnrs doivent se rsoudre sans deviner
+
+// Rgles du jeu (regles.c), sans matriel: compiles aussi par hote/Makefile
+void initTabVue(void);
+void rempliMines(uint8_t nb);
+void metToucheCombien(void);
+bool demine(uint8_t x, uint8_t y);
+bool enleveTuilesAutour(uint8_t x, uint8_t y);
+bool gagne(void);
+void metOuEnleveDrapeau(uint8_t x, uint8_t y);
+
+// Droulement de la partie (partie.c), sans registre: compil aussi par hote/Makefile
+void traiteTick(void);
+void nouvellePartie(void);
+void preparePartie(void);
+void avertitSansGarantie(void);
+void deplace(uint8_t entrees);
+char joue(uint8_t x, uint8_t y);
+void afficheTabVue(void);
+void afficheTabMines(uint8_t x, uint8_t y);
+
+#endif	/* DEMINEUR_H */
@@ -0,0 +1,214 @@
+/**
+ * @file   entrees.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Lecture des entres par tick, enregistrement et rejeu.
+ *
+ * Toutes les entres du jeu passent par entrees_lit(), une fois par tick.
+ * Avec le mme germe pour hasard() (hasard.h) et la mme suite d'entres, une partie se
+ * rejoue donc exactement, tick pour tick. L'enregistrement est compact par
+ * plages: une paire (tat, nombre de ticks) n'est envoye que lorsque l'tat
+ * des entres change. Le format est dcrit dans entrees.h.
+ */
+
+#include <xc.h>
+#include <conio.h>
+#include "veille.h"
+#include "moniteur.h"
+#include "mesure.h"
+#include "entrees.h"
+
+#define _XTAL_FREQ 1000000 //Constante utilise par __delay_ms(x). Doit = frq interne du uC
+#define AXE_X 7  //canal analogique de l'axe x de la manette
+#define AXE_Y 6 //canal analogique de l'axe y de la manette
+#define PORT_SW PORTBbits.RB1 //sw de la manette
+#define SW0 PORTBbits.RB0 //bouton sur la carte noire
+#define SEUIL_BAS 80 //en dessous, le joystick est vers la gauche ou le haut
+#define SEUIL_HAUT 175 //au dessus, le joystick est vers la droite ou le bas
+#define FIN_ENREGISTREMENT 'F'
+#define DEMANDE_PAIRE '?'
+
+unsigned long m_noTick = 0; //nombre de ticks couls depuis le dmarrage
+
+static bool m_enregistre = false; //vrai pendant un enregistrement
+static bool m_rejoue = false; //vrai pendant un rejeu
+static unsigned char m_etatPlage; //tat des entres de la plage en cours
+static unsigned char m_longueurPlage; //nombre de ticks de la plage en cours (0 = aucune)
+
+static unsigned char entrees_litRejeu(void);
+static void entrees_ajoutePlage(unsigned char etat);
+static char getAnalog(char canal);
+
+/*
+ * @brief Attend la fin du tick et lit les entres. Voir entrees.h.
+ * @param rien
+ * @return Combinaison des bits ENTREE_xxx
+ */
+unsigned char entrees_lit(void)
+{
+    unsigned char etat;
+
+    if (m_rejoue) {
+        mesure_finTickRejeu(); //travail du tick prcdent, sans l'attente de l'hte
+        etat = entrees_litRejeu(); //m_rejoue redevient faux  la fin du rejeu
+        if (m_rejoue)
+            mesure_debutTickRejeu();
+        else {
+            mesure_finRejeu(); //rapport du rejeu, aprs le 'F' de l'hte
+            moniteur_suspend(); //le tick qui suit n'a pas d'cart avec le dernier tick avant le rejeu
+        }
+    }
+    if (!m_rejoue) {
+        moniteur_finTick(); //fin du travail du tick prcdent
+        veille_attendTick(); //tick de 100 ms, en veille. dtermine la vitesse de dplacement
+        moniteur_debutTick();
+        etat = entrees_etat();
+    }
+    if (m_enregistre)
+        entrees_ajoutePlage(etat);
+    m_noTick++;
+    return etat;
+}
+
+/*
+ * @brief Commence l'enregistrement. Voir entrees.h.
+ * @param unsigned int germe, unsigned char nbMines, bool sansDevinette
+ * @return rien
+ */
+void entrees_enregistre(unsigned int germe, unsigned char nbMines, bool sansDevinette)
+{
+    putch('E');
+    putch(germe >> 8);
+    putch(germe);
+    putch(nbMines);
+    putch(sansDevinette);
+    for (signed char decalage = 24; decalage >= 0; decalage -= 8)
+        putch(m_noTick >> decalage);
+    m_longueurPlage = 0;
+    m_enregistre = true;
+}
+
+/*
+ * @brief Termine l'enregistrement. Voir entrees.h.
+ * @param rien
+ * @return rien
+ */
+void entrees_arreteEnregistrement(void)
+{
+    if (!m_enregistre)
+        return;
+    if (m_longueurPlage != 0) { //dernire plage pas encore envoye
+        putch(m_etatPlage);
+        putch(m_longueurPlage);
+    }
+    putch(FIN_ENREGISTREMENT);
+    m_enregistre = false;
+}
+
+/*
+ * @brief Indique si un enregistrement est en cours. Voir entrees.h.
+ * @param rien
+ * @return vrai entre entrees_enregistre() et entrees_arreteEnregistrement()
+ */
+bool entrees_enregistreEnCours(void)
+{
+    return m_enregistre;
+}
+
+/*
+ * @brief Passe en rejeu. Voir entrees.h.
+ * @param rien
+ * @return rien
+ */
+void entrees_rejoue(void)
+{
+    m_longueurPlage = 0; //la premire paire sera demande au prochain tick
+    m_rejoue = true;
+    moniteur_suspend(); //le tick en cours et le rejeu ne comptent pas
+}
+
+/*
+ * @brief Lit le joystick et les boutons sur la carte. Voir entrees.h.
+ * @param rien
+ * @return Combinaison des bits ENTREE_xxx
+ */
+unsigned char entrees_etat(void)
+{
+    unsigned char analogX = getAnalog(AXE_X);//valeur entre 0 et 255 qui reprsente la position X du joystick
+    unsigned char analogY = getAnalog(AXE_Y);//valeur entre 0 et 255 qui reprsente la position Y du joystick
+    unsigned char etat = 0;
+
+    if (analogX <= SEUIL_BAS)
+        etat |= ENTREE_GAUCHE;
+    else if (analogX >= SEUIL_HAUT)
+        etat |= ENTREE_DROITE;
+    if (analogY <= SEUIL_BAS)
+        etat |= ENTREE_HAUT;
+    else if (analogY >= SEUIL_HAUT)
+        etat |= ENTREE_BAS;
+    if (PORT_SW == 0)
+        etat |= ENTREE_SW;
+    if (SW0 == 0)
+        etat |= ENTREE_SW0;
+    return etat;
+}
+
+/*
+ * @brief Donne l'tat du tick courant en rejeu. Demande une nouvelle paire
+ *  l'hte quand la plage en cours est puise. Une paire de longueur 0
+ * termine le rejeu comme 'F'.
+ * @param rien
+ * @return Combinaison des bits ENTREE_xxx
+ */
+static unsigned char entrees_litRejeu(void)
+{
+    unsigned char octet;
+
+    if (m_longueurPlage == 0) {
+        putch(DEMANDE_PAIRE);
+        octet = getch();
+        if (octet == FIN_ENREGISTREMENT) { //fin du rejeu: on revient aux entres de la carte
+            m_rejoue = false;
+            return 0;
+        }
+        m_etatPlage = octet;
+        m_longueurPlage = getch();
+        if (m_longueurPlage == 0) { //paire invalide: on arrte plutt que de rejouer 256 ticks
+            m_rejoue = false;
+            return 0;
+        }
+    }
+    m_longueurPlage--;
+    return m_etatPlage;
+}
+
+/*
+ * @brief Ajoute un tick  l'enregistrement. La plage en cours est envoye
+ * quand l'tat change ou quand elle atteint 255 ticks.
+ * @param unsigned char etat L'tat des entres de ce tick
+ * @return rien
+ */
+static void entrees_ajoutePlage(unsigned char etat)
+{
+    if (m_longueurPlage != 0 && (etat != m_etatPlage || m_longueurPlage == 255)) {
+        putch(m_etatPlage);
+        putch(m_longueurPlage);
+        m_longueurPlage = 0;
+    }
+    m_etatPlage = etat;
+    m_longueurPlage++;
+}
+
+/*
+ * @brief Lit le port analogique.
+ * @param Le no du port  lire
+ * @return La valeur des 8 bits de poids forts du port analogique
+ */
+static char getAnalog(char canal)
+{
+    ADCON0bits.CHS = canal;
+    __delay_us(1);
+    ADCON0bits.GO_DONE = 1; //lance une conversion
+    while (ADCON0bits.GO_DONE == 1); //attend fin de la conversion
+    return ADRESH; //retourne seulement les 8 MSB. On laisse tomber les 2 LSB de ADRESL
+}
@@ -0,0 +1,80 @@
+/**
+ * @file   entrees.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Lecture des entres (joystick, SW0) une fois par tick, avec
+ * enregistrement et rejeu par le port srie.
+ *
+ * Format de l'enregistrement (envoy par l'appareil):
+ *  - entte: 'E', germe (2 octets, poids fort d'abord), nombre de mines,
+ *    mode sans devinette (0 ou 1), numro du tick de dpart (4 octets,
+ *    poids fort d'abord);
+ *  - suite de paires (tat, nombre de ticks), o tat est une combinaison
+ *    des bits ENTREE_xxx (toujours < 0x40) et nombre de ticks va de 1  255;
+ *  - fin: 'F'.
+ * Pour le rejeu, l'hte envoie 'R', le germe, le nombre de mines et le mode
+ * (voir commande.h). L'appareil demande ensuite chaque paire en envoyant '?'
+ * et l'hte rpond par la paire suivante ou par 'F'  la fin. Une paire de
+ * longueur 0 est invalide: le rejeu s'arrte comme sur 'F'.  la fin du
+ * rejeu, l'appareil envoie le rapport du rejeu en JSON (format dans mesure.h).
+ * Le mme enregistrement se rejoue sur l'ordinateur avec hote/rejeu, qui
+ * donne le mme tat final.
+ * Pendant l'enregistrement, les commandes refuses (voir commande.h) ajoutent
+ * un 'X' entre deux paires: l'hte doit le sauter.
+ */
+
+#ifndef ENTREES_H
+#define	ENTREES_H
+
+#include <stdbool.h>  // pour l'utilisation du type bool
+
+#define ENTREE_GAUCHE 0x01 //joystick vers la gauche
+#define ENTREE_DROITE 0x02 //joystick vers la droite
+#define ENTREE_HAUT 0x04 //joystick vers le haut
+#define ENTREE_BAS 0x08 //joystick vers le bas
+#define ENTREE_SW 0x10 //bouton du joystick enfonc
+#define ENTREE_SW0 0x20 //bouton SW0 de la carte noire enfonc
+
+extern unsigned long m_noTick; //nombre de ticks couls depuis le dmarrage
+
+/**
+ * @brief Attend en veille la fin du tick courant (100 ms, sauf en rejeu o
+ * les ticks s'enchanent sans attendre) puis lit l'tat des entres. Doit tre appele
+ * une seule fois par tick: c'est elle qui compte les ticks, enregistre et
+ * rejoue.
+ * @return Combinaison des bits ENTREE_xxx
+ */
+unsigned char entrees_lit(void);
+
+/**
+ * @brief Lit tout de suite le joystick et les boutons sur la carte, sans
+ * attendre le tick, sans compter de tick et sans enregistrer. Sert au
+ * dmarrage, avant la premire partie.
+ * @return Combinaison des bits ENTREE_xxx
+ */
+unsigned char entrees_etat(void);
+
+/**
+ * @brief Commence l'enregistrement et envoie l'entte.
+ * @param germe, nbMines, sansDevinette Les paramtres de la partie enregistre
+ */
+void entrees_enregistre(unsigned int germe, unsigned char nbMines, bool sansDevinette);
+
+/**
+ * @brief Termine l'enregistrement en cours (envoie la dernire paire et 'F').
+ */
+void entrees_arreteEnregistrement(void);
+
+/**
+ * @brief Indique si un enregistrement est en cours.
+ * @return vrai entre entrees_enregistre() et entrees_arreteEnregistrement()
+ */
+bool entrees_enregistreEnCours(void);
+
+/**
+ * @brief Passe en rejeu: les entres sont demandes  l'hte au lieu d'tre
+ * lues sur la carte, jusqu' ce que l'hte rponde 'F'.
+ */
+void entrees_rejoue(void);
+
+#endif	/* ENTREES_H */
@@ -0,0 +1,49 @@
+/**
+ * @file   hasard.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Gnrateur xorshift de 16 bits (dcalages 7, 9, 8). Voir hasard.h.
+ *
+ * L'tat est un entier de 16 bits, masqu  chaque dcalage  gauche:
+ * unsigned int a 16 bits sur le PIC, mais 32 sur l'ordinateur.
+ */
+
+#include "demineur.h"
+#include "hasard.h"
+
+static LOCAL_FIL unsigned int m_etat = 1; //jamais nul
+
+/*
+ * @brief Recommence la suite. Voir hasard.h.
+ * @param unsigned int germe Le germe
+ * @return rien
+ */
+void hasard_germe(unsigned int germe)
+{
+    m_etat = germe & 0xFFFF;
+    if (m_etat == 0)
+        m_etat = 1;
+}
+
+/*
+ * @brief Nombre suivant de la suite. Voir hasard.h.
+ * @param rien
+ * @return un nombre de 1  65535
+ */
+unsigned int hasard(void)
+{
+    m_etat ^= (m_etat << 7) & 0xFFFF;
+    m_etat ^= m_etat >> 9;
+    m_etat ^= (m_etat << 8) & 0xFFFF;
+    return m_etat;
+}
+
+/*
+ * @brief tat courant de la suite. Voir hasard.h.
+ * @param rien
+ * @return l'tat, de 1  65535
+ */
+unsigned int hasard_etat(void)
+{
+    return m_etat;
+}
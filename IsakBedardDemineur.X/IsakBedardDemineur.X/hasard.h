@@ -0,0 +1,38 @@
+/**
+ * @file   hasard.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Gnrateur pseudo-alatoire du jeu.
+ *
+ * rand() n'est pas le mme avec XC8 et avec la bibliothque C de
+ * l'ordinateur: un germe ne donnait pas le mme champ sur les deux. Ce
+ * gnrateur (xorshift de 16 bits, priode 65535) donne la mme suite
+ * partout: un enregistrement (germe, voir entrees.h) se rejoue aussi sur
+ * l'ordinateur (hote/rejeu.c), et hote/ gnre les mmes champs que le PIC.
+ */
+
+#ifndef HASARD_H
+#define	HASARD_H
+
+/**
+ * @brief Recommence la suite  partir d'un germe. Le germe 0 donne la mme
+ * suite que le germe 1 (l'tat d'un xorshift ne doit jamais tre nul).
+ * @param germe Les 16 bits du germe
+ */
+void hasard_germe(unsigned int germe);
+
+/**
+ * @brief Tire le nombre suivant de la suite.
+ * @return Un nombre de 1  65535
+ */
+unsigned int hasard(void);
+
+/**
+ * @brief Donne l'tat courant de la suite, sans l'avancer. hasard_germe()
+ * avec cet tat reprend la suite au mme endroit: hote/serveur.c garde
+ * ainsi une suite par partie, avec un seul gnrateur par fil.
+ * @return L'tat, de 1  65535
+ */
+unsigned int hasard_etat(void);
+
+#endif	/* HASARD_H */
@@ -0,0 +1,192 @@
+/**
+ * @file   banc.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Compare sur l'ordinateur la vitesse des rgles spcialises sur
+ * NB_LIGNE x NB_COL (regles.c) et de la version de taille variable
+ * (reference.c).
+ *
+ * Usage: banc [nombre de rptitions]   (21 par dfaut)
+ * Chaque rptition passe NB_PASSES fois sur les mmes NB_CHAMPS champs
+ * gnrs par rempliMines(). Rponse (une ligne JSON, dures en ns par appel):
+ *  {"taille":"4x20","repetitions":21,
+ *   "chiffres":{"fixe":{"min":..,"p50":..,"p90":..},"variable":{..},"rapport":..},
+ *   "enleve":{..}}
+ * o rapport est le p50 de la version variable divis par celui de la
+ * version fixe. Sous 1, la version fixe est plus lente: la mtrique porte
+ * alors "regression":true. La taille se choisit  la compilation
+ * (hote/Makefile: banc, banc9x9, banc16x30). Les dures sont celles de l'ordinateur: elles servent 
+ * comparer les deux versions entre elles, pas  prdire le temps sur le PIC
+ * (commande 'P', voir mesure.h).
+ */
+
+#define _POSIX_C_SOURCE 199309L //clock_gettime()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../demineur.h"
+#include "reference.h"
+
+#define NB_CHAMPS 256 //champs diffrents, de 0  40 mines
+#define NB_PASSES 200 //passes sur les NB_CHAMPS champs par rptition
+#define NB_MAX_REPETITIONS 101
+
+#define VERSION_FIXE 0
+#define VERSION_VARIABLE 1
+
+static char m_champs[NB_CHAMPS][NB_LIGNE][NB_COL + 1]; //mines et espaces seulement
+static char m_copie[NB_LIGNE][NB_COL + 1]; //champ de la version variable
+static double m_durees[NB_MAX_REPETITIONS];
+static volatile int m_puits; //empche le compilateur de supprimer les appels
+
+static double banc_chiffres(int version);
+static double banc_enleve(int version);
+static void banc_envoie(const char* nom, double (*mesure)(int), int nbRepetitions);
+static double banc_p50(double (*mesure)(int), int version, int nbRepetitions);
+static double banc_maintenant(void);
+static int banc_compare(const void* a, const void* b);
+
+int main(int argc, char** argv)
+{
+    int nbRepetitions = (argc > 1) ? atoi(argv[1]) : 21;
+
+    if (nbRepetitions < 1 || nbRepetitions > NB_MAX_REPETITIONS)
+        nbRepetitions = 21;
+    srand(1);
+    for (int c = 0; c < NB_CHAMPS; c++) {
+        rempliMines(rand() % 41);
+        memcpy(m_champs[c], m_tabMines, sizeof m_tabMines);
+    }
+    printf("{\"taille\":\"%dx%d\",\"repetitions\":%d", NB_LIGNE, NB_COL, nbRepetitions);
+    banc_envoie("chiffres", banc_chiffres, nbRepetitions);
+    banc_envoie("enleve", banc_enleve, nbRepetitions);
+    printf("}\n");
+    return 0;
+}
+
+/*
+ * @brief Calcule les chiffres de tous les champs, NB_PASSES fois.
+ * @param version VERSION_FIXE ou VERSION_VARIABLE
+ * @return la dure moyenne d'un appel, en ns
+ */
+static double banc_chiffres(int version)
+{
+    double debut = banc_maintenant();
+
+    for (int p = 0; p < NB_PASSES; p++) {
+        for (int c = 0; c < NB_CHAMPS; c++) {
+            if (version == VERSION_FIXE) {
+                memcpy(m_tabMines, m_champs[c], sizeof m_tabMines);
+                metToucheCombien();
+                m_puits += m_tabMines[c % NB_LIGNE][c % NB_COL];
+            } else {
+                memcpy(m_copie, m_champs[c], sizeof m_copie);
+                reference_chiffres(&m_copie[0][0], NB_LIGNE, NB_COL, NB_COL + 1);
+                m_puits += m_copie[c % NB_LIGNE][c % NB_COL];
+            }
+        }
+    }
+    return (banc_maintenant() - debut) / (NB_PASSES * NB_CHAMPS);
+}
+
+/*
+ * @brief Enlve les tuiles autour de chaque case de chaque champ, en partant
+ * d'une vue pleine de tuiles.
+ * @param version VERSION_FIXE ou VERSION_VARIABLE
+ * @return la dure moyenne d'un appel, en ns
+ */
+static double banc_enleve(int version)
+{
+    double debut;
+    int nbAppels = 0;
+
+    for (int c = 0; c < NB_CHAMPS; c++) { //les chiffres ne sont pas mesurs ici
+        memcpy(m_tabMines, m_champs[c], sizeof m_tabMines);
+        metToucheCombien();
+        memcpy(m_champs[c], m_tabMines, sizeof m_tabMines);
+    }
+    debut = banc_maintenant();
+    for (int p = 0; p < NB_PASSES / 10; p++) {
+        for (int c = 0; c < NB_CHAMPS; c++) {
+            memcpy(m_tabMines, m_champs[c], sizeof m_tabMines);
+            initTabVue();
+            for (uint8_t y = 1; y <= NB_LIGNE; y++) {
+                for (uint8_t x = 1; x <= NB_COL; x++) {
+                    if (version == VERSION_FIXE)
+                        m_puits += enleveTuilesAutour(x, y);
+                    else
+                        m_puits += reference_enleveTuilesAutour(&m_tabVue[0][0], &m_tabMines[0][0],
+                                                                NB_LIGNE, NB_COL, NB_COL + 1, x, y);
+                    nbAppels++;
+                }
+            }
+        }
+    }
+    return (banc_maintenant() - debut) / nbAppels;
+}
+
+/*
+ * @brief Mesure les deux versions et crit le rsultat d'une mtrique.
+ * @param nom Le nom de la mtrique dans la rponse
+ * @param mesure banc_chiffres ou banc_enleve
+ * @param nbRepetitions Nombre de mesures de chaque version
+ * @return rien
+ */
+static void banc_envoie(const char* nom, double (*mesure)(int), int nbRepetitions)
+{
+    static const char* const versions[] = {"fixe", "variable"};
+    double p50[2];
+
+    printf(",\"%s\":{", nom);
+    for (int v = VERSION_FIXE; v <= VERSION_VARIABLE; v++) {
+        p50[v] = banc_p50(mesure, v, nbRepetitions);
+        printf("\"%s\":{\"min\":%.1f,\"p50\":%.1f,\"p90\":%.1f},", versions[v], m_durees[0], p50[v],
+               m_durees[nbRepetitions * 9 / 10]);
+    }
+    printf("\"rapport\":%.2f", p50[VERSION_VARIABLE] / p50[VERSION_FIXE]);
+    if (p50[VERSION_VARIABLE] < p50[VERSION_FIXE])
+        printf(",\"regression\":true");
+    printf("}");
+}
+
+/*
+ * @brief Rpte une mesure et trie les dures dans m_durees.
+ * @param mesure, version La mesure  rpter
+ * @param nbRepetitions Nombre de mesures
+ * @return la mdiane, en ns
+ */
+static double banc_p50(double (*mesure)(int), int version, int nbRepetitions)
+{
+    mesure(version); //rchauffe les caches
+    for (int r = 0; r < nbRepetitions; r++)
+        m_durees[r] = mesure(version);
+    qsort(m_durees, nbRepetitions, sizeof m_durees[0], banc_compare);
+    return m_durees[nbRepetitions / 2];
+}
+
+/*
+ * @brief Lit l'horloge monotone.
+ * @param rien
+ * @return le temps en ns
+ */
+static double banc_maintenant(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+/*
+ * @brief Ordre croissant pour qsort().
+ * @param a, b Deux dures
+ * @return ngatif, nul ou positif
+ */
+static int banc_compare(const void* a, const void* b)
+{
+    double da = *(const double*) a;
+    double db = *(const double*) b;
+
+    return (da > db) - (da < db);
+}
@@ -0,0 +1,364 @@
+/**
+ * @file   banclot.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Vrifie et mesure les lots de parties (lot.h) contre une boucle
+ * d'appels de regles.c, un champ  la fois.
+ *
+ * Usage: banclot [-n champs] [-p pas] [-m mines] [-f fils] [-v]
+ *  -n  champs jous ensemble (4096 par dfaut)
+ *  -p  pas jous (200 par dfaut); un pas sur PAS_DRAPEAU est un drapeau
+ *  -m  mines de la premire partie de chaque champ (10 par dfaut)
+ *  -f  fils du lot (par dfaut: un par coeur)
+ *  -v  vrifie seulement:  chaque pas, le rsultat et la vue de chaque
+ *      champ du lot doivent tre ceux de la boucle
+ *
+ * La boucle garde chaque champ dans sa structure (m_tabVue, m_tabMines,
+ * nombre de mines, tat de hasard()) et le copie dans l'tat du jeu pour
+ * chaque appel de demine() et gagne(), comme un serveur de parties. Les
+ * deux cts jouent les mmes cases, tires d'avance; les clics au hasard
+ * perdent souvent, et chaque partie perdue en tire une nouvelle par
+ * rempliMines(), des deux cts.
+ *
+ * Une ligne JSON (pas par seconde = champs x pas / dure, p50 de
+ * NB_REPETITIONS):
+ *  {"taille":"4x20","champs":..,"pas":..,"fils":..,
+ *   "pas_par_s":{"boucle":..,"lot":..,"lot_vues":..},"rapport":..}
+ * o lot_vues copie aussi les vues  chaque pas et rapport est lot / boucle.
+ */
+
+#define _POSIX_C_SOURCE 200809L //clock_gettime(), getopt(), sysconf()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../demineur.h"
+#include "../hasard.h"
+#include "lot.h"
+
+#define CHAMPS_DEFAUT 4096
+#define PAS_DEFAUT 200
+#define MINES_DEFAUT 10
+#define PAS_DRAPEAU 5 //un pas sur 5 met un drapeau
+#define NB_REPETITIONS 5
+
+/*
+ * Un champ de la boucle d'appels.
+ */
+typedef struct {
+    char vue[NB_LIGNE][NB_COL + 1];
+    char mines[NB_LIGNE][NB_COL + 1];
+    uint8_t nbMines;
+    unsigned int hasard;
+} Champ;
+
+static unsigned int m_nbChamps = CHAMPS_DEFAUT;
+static unsigned int m_nbPas = PAS_DEFAUT;
+static uint8_t* m_x; //case de chaque pas et de chaque champ: m_x[pas * m_nbChamps + champ]
+static uint8_t* m_y;
+static unsigned int* m_germes;
+static uint8_t* m_mines0;
+
+static long banclot_verifie(Lot* lot, Champ* champs, unsigned char* vues, char* resultats);
+static double banclot_boucle(Champ* champs);
+static double banclot_lot(Lot* lot, unsigned char* vues, char* resultats);
+static void banclot_reinitialise(Champ* champ, unsigned int germe, uint8_t nbMines);
+static char banclot_devoile(Champ* champ, uint8_t x, uint8_t y);
+static void banclot_drapeau(Champ* champ, uint8_t x, uint8_t y);
+static void banclot_prepare(Champ* champ);
+static double banclot_p50(double* durees);
+static int banclot_compare(const void* a, const void* b);
+static double banclot_maintenant(void);
+
+int main(int argc, char** argv)
+{
+    long nbFils = sysconf(_SC_NPROCESSORS_ONLN);
+    int nbMines = MINES_DEFAUT;
+    bool verification = false;
+    double boucle[NB_REPETITIONS], lotSeul[NB_REPETITIONS], lotVues[NB_REPETITIONS];
+    uint64_t alea = 88172645463325252u;
+    unsigned char* vues;
+    char* resultats;
+    Champ* champs;
+    Lot* lot;
+    long nbErreurs;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:p:m:f:v")) != -1) {
+        switch (opt) {
+            case 'n':
+                m_nbChamps = atol(optarg);
+                break;
+            case 'p':
+                m_nbPas = atol(optarg);
+                break;
+            case 'm':
+                nbMines = atoi(optarg);
+                break;
+            case 'f':
+                nbFils = atol(optarg);
+                break;
+            case 'v':
+                verification = true;
+                break;
+            default:
+                fprintf(stderr, "usage: banclot [-n champs] [-p pas] [-m mines] [-f fils] [-v]\n");
+                return 2;
+        }
+    }
+    if (m_nbChamps < 1 || m_nbPas < 1 || nbMines < 1 || nbMines >= NB_CASES || nbFils < 1) {
+        fprintf(stderr, "banclot: options invalides\n");
+        return 2;
+    }
+
+    m_x = malloc((size_t) m_nbPas * m_nbChamps);
+    m_y = malloc((size_t) m_nbPas * m_nbChamps);
+    m_germes = malloc(m_nbChamps * sizeof *m_germes);
+    m_mines0 = malloc(m_nbChamps);
+    champs = malloc(m_nbChamps * sizeof *champs);
+    vues = malloc((size_t) m_nbChamps * NB_CASES);
+    resultats = malloc(m_nbChamps);
+    lot = lot_cree(m_nbChamps, nbFils);
+    if (m_x == NULL || m_y == NULL || m_germes == NULL || m_mines0 == NULL || champs == NULL
+            || vues == NULL || resultats == NULL || lot == NULL) {
+        fprintf(stderr, "banclot: memoire insuffisante\n");
+        return 1;
+    }
+    for (size_t i = 0; i < (size_t) m_nbPas * m_nbChamps; i++) { //xorshift64*
+        alea ^= alea >> 12;
+        alea ^= alea << 25;
+        alea ^= alea >> 27;
+        m_x[i] = 1 + ((alea * 0x2545F4914F6CDD1Du) >> 32) % NB_COL;
+        m_y[i] = 1 + ((alea * 0x2545F4914F6CDD1Du) >> 48) % NB_LIGNE;
+    }
+    for (unsigned int k = 0; k < m_nbChamps; k++) {
+        m_germes[k] = k + 1;
+        m_mines0[k] = nbMines;
+    }
+
+    if (verification) {
+        nbErreurs = banclot_verifie(lot, champs, vues, resultats);
+        if (nbErreurs != 0) {
+            printf("banclot: %ld differences avec regles.c\n", nbErreurs);
+            return 1;
+        }
+        printf("banclot: %u champs x %u pas identiques a regles.c (%ld fils)\n", m_nbChamps, m_nbPas, nbFils);
+        lot_detruit(lot);
+        return 0;
+    }
+
+    for (int r = 0; r < NB_REPETITIONS; r++) {
+        boucle[r] = banclot_boucle(champs);
+        lotSeul[r] = banclot_lot(lot, NULL, resultats);
+        lotVues[r] = banclot_lot(lot, vues, resultats);
+    }
+    printf("{\"taille\":\"%dx%d\",\"champs\":%u,\"pas\":%u,\"fils\":%ld,"
+            "\"pas_par_s\":{\"boucle\":%.0f,\"lot\":%.0f,\"lot_vues\":%.0f},\"rapport\":%.2f}\n",
+            NB_LIGNE, NB_COL, m_nbChamps, m_nbPas, nbFils,
+            (double) m_nbChamps * m_nbPas / banclot_p50(boucle),
+            (double) m_nbChamps * m_nbPas / banclot_p50(lotSeul),
+            (double) m_nbChamps * m_nbPas / banclot_p50(lotVues),
+            banclot_p50(boucle) / banclot_p50(lotSeul));
+    lot_detruit(lot);
+    return 0;
+}
+
+/*
+ * @brief Joue tous les pas des deux cts et compare les rsultats et les
+ * vues aprs chaque pas.
+ * @param Lot* lot Le lot
+ * @param Champ* champs Les champs de la boucle
+ * @param unsigned char* vues, char* resultats Rponses du lot
+ * @return le nombre de diffrences
+ */
+static long banclot_verifie(Lot* lot, Champ* champs, unsigned char* vues, char* resultats)
+{
+    long nbErreurs = 0;
+    const uint8_t* x;
+    const uint8_t* y;
+    char resultat;
+
+    lot_reinitialise(lot, m_germes, m_mines0, vues);
+    for (unsigned int k = 0; k < m_nbChamps; k++) {
+        banclot_reinitialise(&champs[k], m_germes[k], m_mines0[k]);
+        for (unsigned int c = 0; c < NB_CASES; c++)
+            nbErreurs += vues[(size_t) c * m_nbChamps + k] != (unsigned char) champs[k].vue[c / NB_COL][c % NB_COL];
+    }
+    for (unsigned int p = 0; p < m_nbPas; p++) {
+        x = m_x + (size_t) p * m_nbChamps;
+        y = m_y + (size_t) p * m_nbChamps;
+        if (p % PAS_DRAPEAU == PAS_DRAPEAU - 1)
+            lot_drapeau(lot, x, y, vues);
+        else
+            lot_devoile(lot, x, y, resultats, vues);
+        for (unsigned int k = 0; k < m_nbChamps; k++) {
+            if (p % PAS_DRAPEAU == PAS_DRAPEAU - 1)
+                banclot_drapeau(&champs[k], x[k], y[k]);
+            else {
+                resultat = banclot_devoile(&champs[k], x[k], y[k]);
+                nbErreurs += resultats[k] != resultat;
+            }
+            for (unsigned int c = 0; c < NB_CASES; c++)
+                nbErreurs += vues[(size_t) c * m_nbChamps + k] != (unsigned char) champs[k].vue[c / NB_COL][c % NB_COL];
+        }
+    }
+    return nbErreurs;
+}
+
+/*
+ * @brief Joue tous les pas avec la boucle d'appels, un champ  la fois.
+ * @param Champ* champs Les champs
+ * @return la dure en secondes
+ */
+static double banclot_boucle(Champ* champs)
+{
+    double debut = banclot_maintenant();
+    const uint8_t* x;
+    const uint8_t* y;
+    volatile char puits; //garde les rsultats
+
+    for (unsigned int k = 0; k < m_nbChamps; k++)
+        banclot_reinitialise(&champs[k], m_germes[k], m_mines0[k]);
+    for (unsigned int p = 0; p < m_nbPas; p++) {
+        x = m_x + (size_t) p * m_nbChamps;
+        y = m_y + (size_t) p * m_nbChamps;
+        for (unsigned int k = 0; k < m_nbChamps; k++) {
+            if (p % PAS_DRAPEAU == PAS_DRAPEAU - 1)
+                banclot_drapeau(&champs[k], x[k], y[k]);
+            else
+                puits = banclot_devoile(&champs[k], x[k], y[k]);
+        }
+    }
+    (void) puits;
+    return banclot_maintenant() - debut;
+}
+
+/*
+ * @brief Joue tous les pas avec le lot.
+ * @param Lot* lot Le lot
+ * @param unsigned char* vues Reoit les vues  chaque pas, ou NULL
+ * @param char* resultats Reoit les rsultats
+ * @return la dure en secondes
+ */
+static double banclot_lot(Lot* lot, unsigned char* vues, char* resultats)
+{
+    double debut = banclot_maintenant();
+    const uint8_t* x;
+    const uint8_t* y;
+
+    lot_reinitialise(lot, m_germes, m_mines0, vues);
+    for (unsigned int p = 0; p < m_nbPas; p++) {
+        x = m_x + (size_t) p * m_nbChamps;
+        y = m_y + (size_t) p * m_nbChamps;
+        if (p % PAS_DRAPEAU == PAS_DRAPEAU - 1)
+            lot_drapeau(lot, x, y, vues);
+        else
+            lot_devoile(lot, x, y, resultats, vues);
+    }
+    return banclot_maintenant() - debut;
+}
+
+/*
+ * @brief Nouvelle partie sur un champ de la boucle.
+ * @param Champ* champ Le champ
+ * @param unsigned int germe Le germe de hasard()
+ * @param uint8_t nbMines Le nombre de mines
+ * @return rien
+ */
+static void banclot_reinitialise(Champ* champ, unsigned int germe, uint8_t nbMines)
+{
+    champ->hasard = germe;
+    champ->nbMines = nbMines;
+    banclot_prepare(champ);
+}
+
+/*
+ * @brief Dvoile une case d'un champ de la boucle, comme joue() puis
+ * preparePartie() si la partie est termine.
+ * @param Champ* champ Le champ
+ * @param uint8_t x, uint8_t y La case
+ * @return PARTIE_EN_COURS, PARTIE_GAGNEE ou PARTIE_PERDUE
+ */
+static char banclot_devoile(Champ* champ, uint8_t x, uint8_t y)
+{
+    char resultat = PARTIE_EN_COURS;
+
+    memcpy(m_tabVue, champ->vue, sizeof m_tabVue);
+    memcpy(m_tabMines, champ->mines, sizeof m_tabMines);
+    m_partie.nbMines = champ->nbMines;
+    if (!demine(x, y))
+        resultat = PARTIE_PERDUE;
+    else if (gagne())
+        resultat = PARTIE_GAGNEE;
+    champ->nbMines = m_partie.nbMines;
+    if (resultat != PARTIE_EN_COURS)
+        banclot_prepare(champ);
+    else
+        memcpy(champ->vue, m_tabVue, sizeof m_tabVue);
+    return resultat;
+}
+
+/*
+ * @brief Met ou enlve un drapeau sur un champ de la boucle.
+ * @param Champ* champ Le champ
+ * @param uint8_t x, uint8_t y La case
+ * @return rien
+ */
+static void banclot_drapeau(Champ* champ, uint8_t x, uint8_t y)
+{
+    memcpy(m_tabVue, champ->vue, sizeof m_tabVue);
+    metOuEnleveDrapeau(x, y);
+    memcpy(champ->vue, m_tabVue, sizeof m_tabVue);
+}
+
+/*
+ * @brief Tire un champ avec la suite de hasard() du champ, comme
+ * preparePartie() hors mode sans devinette.
+ * @param Champ* champ Le champ
+ * @return rien
+ */
+static void banclot_prepare(Champ* champ)
+{
+    hasard_germe(champ->hasard);
+    rempliMines(champ->nbMines);
+    metToucheCombien();
+    initTabVue();
+    champ->hasard = hasard_etat();
+    memcpy(champ->vue, m_tabVue, sizeof m_tabVue);
+    memcpy(champ->mines, m_tabMines, sizeof m_tabMines);
+}
+
+/*
+ * @brief Mdiane des dures.
+ * @param double* durees NB_REPETITIONS dures, tries sur place
+ * @return la mdiane
+ */
+static double banclot_p50(double* durees)
+{
+    qsort(durees, NB_REPETITIONS, sizeof *durees, banclot_compare);
+    return durees[NB_REPETITIONS / 2];
+}
+
+/*
+ * @brief Ordre croissant, pour qsort().
+ */
+static int banclot_compare(const void* a, const void* b)
+{
+    double da = *(const double*) a, db = *(const double*) b;
+
+    return (da > db) - (da < db);
+}
+
+/*
+ * @brief Temps monotone en secondes.
+ * @param rien
+ * @return le temps
+ */
+static double banclot_maintenant(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
@@ -0,0 +1,257 @@
+/**
+ * @file   carte.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Carte mule pour le rejeu sur l'ordinateur. Voir carte.h.
+ *
+ * Le PIC termine un rejeu dans entrees_lit(), au premier tick qui n'est
+ * plus dans l'enregistrement. Ici, entrees_lit() revient alors directement
+ * dans carte_rejoue() (longjmp): l'tat de la partie est celui que le PIC
+ * a au moment d'envoyer son rapport de rejeu (mesure.h).
+ *
+ * Pour rejouer un seul tick, entrees_lit() note le dbut du tick voulu et
+ * revient dans carte_rejoue() au dbut du tick suivant. Pendant ce tick,
+ * moniteur_tache() compte le temps de chaque tche comme le moniteur du PIC.
+ */
+
+#define _POSIX_C_SOURCE 199309L //clock_gettime()
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "xc.h"
+#include "../Lcd4Lignes.h"
+#include "../demineur.h"
+#include "../hasard.h"
+#include "../entrees.h"
+#include "../stats.h"
+#include "../moniteur.h"
+#include "../veille.h"
+#include "carte.h"
+
+#define DEBUT_ENREGISTREMENT 'E'
+#define FIN_ENREGISTREMENT 'F'
+#define REFUS 'X' //commande refuse pendant l'enregistrement
+
+PortA PORTAbits;
+T1Con T1CONbits;
+unsigned char TRISD;
+unsigned char m_portD[2];
+unsigned long m_noTick; //numro du tick, compt comme sur le PIC depuis le tick de dpart
+
+static const Enregistrement* m_enr; //enregistrement en cours de rejeu
+static unsigned long m_paire; //prochaine paire
+static unsigned char m_etat; //tat de la plage en cours
+static unsigned char m_restant; //ticks restants dans la plage en cours
+static jmp_buf m_fin; //retour dans carte_rejoue() aprs le dernier tick
+static TickRejoue* m_tick; //tick rejou seul, NULL pour tout rejouer
+static unsigned long m_noCible; //m_noTick du tick rejou seul
+static bool m_mesure; //vrai pendant le tick rejou seul
+static unsigned char m_tache; //tche en cours du tick rejou seul
+static double m_debutTache; //dbut de la tche en cours, en ns
+static unsigned int m_ecrituresTick; //m_nbEcrituresLcd au dbut du tick rejou seul
+
+static unsigned long carte_joue(const Enregistrement* enr);
+static double carte_maintenant(void);
+
+/*
+ * @brief Lit un enregistrement. Voir carte.h.
+ * @param FILE* entree, Enregistrement* enr Voir carte.h
+ * @return faux si l'entte ou la fin manque
+ */
+bool carte_litEnregistrement(FILE* entree, Enregistrement* enr)
+{
+    unsigned long capacite = 64;
+    int octet, longueur;
+
+    if (getc(entree) != DEBUT_ENREGISTREMENT)
+        return false;
+    enr->germe = getc(entree) << 8;
+    enr->germe |= getc(entree);
+    enr->nbMines = getc(entree);
+    enr->sansDevinette = getc(entree) != 0;
+    enr->tickDepart = 0;
+    for (int i = 0; i < 4; i++)
+        enr->tickDepart = (enr->tickDepart << 8) | getc(entree);
+    enr->nbPaires = 0;
+    enr->nbTicks = 0;
+    enr->paires = malloc(capacite * sizeof *enr->paires);
+    while ((octet = getc(entree)) != EOF && octet != FIN_ENREGISTREMENT) {
+        if (octet == REFUS)
+            continue;
+        longueur = getc(entree);
+        if (longueur == EOF)
+            break;
+        if (longueur == 0) //le PIC arrte le rejeu sur une paire invalide
+            return true;
+        if (enr->nbPaires == capacite) {
+            capacite *= 2;
+            enr->paires = realloc(enr->paires, capacite * sizeof *enr->paires);
+        }
+        enr->paires[enr->nbPaires][0] = octet;
+        enr->paires[enr->nbPaires][1] = longueur;
+        enr->nbPaires++;
+        enr->nbTicks += longueur;
+    }
+    return octet == FIN_ENREGISTREMENT;
+}
+
+/*
+ * @brief Libre un enregistrement. Voir carte.h.
+ * @param Enregistrement* enr L'enregistrement
+ * @return rien
+ */
+void carte_libere(Enregistrement* enr)
+{
+    free(enr->paires);
+    enr->paires = NULL;
+    enr->nbPaires = 0;
+}
+
+/*
+ * @brief Rejoue un enregistrement. Voir carte.h. Mme suite d'appels que la
+ * commande 'R' (commande_rejoue()), puis la boucle de main().
+ * @param const Enregistrement* enr L'enregistrement
+ * @return le nombre d'octets crits au LCD pendant le rejeu
+ */
+unsigned long carte_rejoue(const Enregistrement* enr)
+{
+    m_tick = NULL;
+    return carte_joue(enr);
+}
+
+/*
+ * @brief Rejoue jusqu' la fin d'un tick et le mesure. Voir carte.h.
+ * @param const Enregistrement* enr L'enregistrement
+ * @param unsigned long noTick Le tick
+ * @param TickRejoue* tick Reoit ce qu'a fait le tick
+ * @return faux si le tick n'est pas dans l'enregistrement
+ */
+bool carte_rejoueTick(const Enregistrement* enr, unsigned long noTick, TickRejoue* tick)
+{
+    if (noTick < enr->tickDepart || noTick - enr->tickDepart >= enr->nbTicks)
+        return false;
+    memset(tick, 0, sizeof *tick);
+    m_tick = tick;
+    m_noCible = noTick;
+    m_mesure = false;
+    carte_joue(enr);
+    m_tick = NULL;
+    m_mesure = false;
+    return true;
+}
+
+/*
+ * @brief Rejoue comme 'R', jusqu'au retour par m_fin.
+ * @param const Enregistrement* enr L'enregistrement
+ * @return le nombre d'octets crits au LCD pendant le rejeu
+ */
+static unsigned long carte_joue(const Enregistrement* enr)
+{
+    static unsigned int debut; //static: gard aprs le longjmp
+
+    m_enr = enr;
+    m_paire = 0;
+    m_restant = 0;
+    m_noTick = enr->tickDepart;
+    m_partie.nbMines = enr->nbMines;
+    m_sansDevinette = enr->sansDevinette;
+    lcd_init();
+    debut = m_nbEcrituresLcd;
+    hasard_germe(enr->germe);
+    if (setjmp(m_fin) == 0) {
+        nouvellePartie();
+        m_partie.x = X_DEPART;
+        m_partie.y = Y_DEPART;
+        for (;;)
+            traiteTick();
+    }
+    return (m_nbEcrituresLcd - debut) & 0xFFFF; //compt en unsigned int de 16 bits sur le PIC
+}
+
+/*
+ * @brief Donne l'tat du tick suivant de l'enregistrement, comme
+ * entrees_lit() en rejeu sur le PIC. Aprs le dernier tick, revient dans
+ * carte_rejoue().
+ * @param rien
+ * @return Combinaison des bits ENTREE_xxx
+ */
+unsigned char entrees_lit(void)
+{
+    if (m_mesure) { //fin du tick rejou seul
+        moniteur_tache(TACHE_ENTREES); //termine la tche en cours
+        m_tick->lcdOctets = (m_nbEcrituresLcd - m_ecrituresTick) & 0xFFFF;
+        longjmp(m_fin, 1);
+    }
+    if (m_tick != NULL && m_noTick == m_noCible) {
+        m_mesure = true;
+        m_tache = TACHE_ENTREES;
+        m_ecrituresTick = m_nbEcrituresLcd;
+        m_debutTache = carte_maintenant();
+    }
+    if (m_restant == 0) {
+        if (m_paire == m_enr->nbPaires)
+            longjmp(m_fin, 1);
+        m_etat = m_enr->paires[m_paire][0];
+        m_restant = m_enr->paires[m_paire][1];
+        m_paire++;
+    }
+    m_restant--;
+    m_noTick++;
+    if (m_mesure)
+        m_tick->etat = m_etat;
+    return m_etat;
+}
+
+/*
+ * @brief Les statistiques ne sont pas conserves sur l'ordinateur.
+ */
+void stats_debutPartie(uint8_t nbMines)
+{
+}
+
+void stats_clic(void)
+{
+}
+
+void stats_finPartie(bool gagne)
+{
+}
+
+/*
+ * @brief Le moniteur du PIC ne fonctionne qu'en temps rel (moniteur.h):
+ * seul le tick rejou seul est mesur, en ns.
+ */
+void moniteur_tache(unsigned char tache)
+{
+    double maintenant;
+
+    if (!m_mesure)
+        return;
+    maintenant = carte_maintenant();
+    m_tick->ns[m_tache] += maintenant - m_debutTache;
+    m_debutTache = maintenant;
+    m_tache = tache;
+}
+
+/*
+ * @brief Le Timer1 est arrt (xc.h): lcd_init() n'appelle pas cette
+ * fonction, qui doit seulement exister.
+ */
+unsigned long veille_cycles(void)
+{
+    return 0;
+}
+
+/*
+ * @brief Temps monotone.
+ * @param rien
+ * @return le temps en ns
+ */
+static double carte_maintenant(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file   carte.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Carte mule: ce que partie.c attend du PIC, pour rejouer un
+ * enregistrement des entres sur l'ordinateur.
+ *
+ * partie.c et Lcd4Lignes.c sont compils tels quels. carte.c fournit les
+ * registres du LCD (xc.h), les entres lues dans l'enregistrement au lieu du
+ * joystick, et des statistiques et un moniteur qui ne font rien. Le rejeu
+ * fait ce que fait le PIC  la rception de 'R' (commande.h): mme LCD
+ * rinitialis, mme germe, mme nouvelle partie, puis un appel de
+ * traiteTick() par tick, comme main().
+ */
+
+#ifndef CARTE_H
+#define	CARTE_H
+
+#include <stdbool.h>  // pour l'utilisation du type bool
+#include <stdint.h>  // pour les types de taille fixe (uint8_t)
+#include <stdio.h>
+#include "../moniteur.h"
+
+/*
+ * Enregistrement des entres (format dans entrees.h).
+ */
+typedef struct {
+    unsigned int germe;
+    uint8_t nbMines;
+    bool sansDevinette;
+    unsigned long tickDepart; //m_noTick au dbut de l'enregistrement
+    unsigned long nbPaires;
+    unsigned char (*paires)[2]; //(tat, nombre de ticks)
+    unsigned long nbTicks; //somme des nombres de ticks
+} Enregistrement;
+
+/*
+ * Un tick rejou seul (carte_rejoueTick()): ce qu'il a fait, pour
+ * retrouver la cause d'un dpassement not par le moniteur du PIC.
+ */
+typedef struct {
+    unsigned char etat; //entres du tick (bits ENTREE_xxx)
+    unsigned long lcdOctets; //octets crits au LCD pendant le tick
+    double ns[NB_TACHES]; //temps de chaque tche (TACHE_xxx) sur l'ordinateur
+} TickRejoue;
+
+/**
+ * @brief Lit un enregistrement tel que l'appareil l'envoie: 'E', entte,
+ * paires (les 'X' des commandes refuses sont sauts), 'F'. Une paire de
+ * longueur 0 termine l'enregistrement, comme au rejeu sur le PIC.
+ * @param entree Le fichier
+ * @param enr Reoit l'enregistrement; librer avec carte_libere()
+ * @return faux si l'entte ou la fin manque
+ */
+bool carte_litEnregistrement(FILE* entree, Enregistrement* enr);
+
+/**
+ * @brief Libre les paires d'un enregistrement.
+ * @param enr L'enregistrement
+ */
+void carte_libere(Enregistrement* enr);
+
+/**
+ * @brief Rejoue un enregistrement jusqu' son dernier tick. L'tat final
+ * est dans m_partie, m_tabMines et m_tabVue.
+ * @param enr L'enregistrement
+ * @return le nombre d'octets crits au LCD pendant le rejeu
+ */
+unsigned long carte_rejoue(const Enregistrement* enr);
+
+/**
+ * @brief Rejoue un enregistrement jusqu' la fin du tick donn, en mesurant
+ * ce tick. L'tat aprs le tick est dans m_partie, m_tabMines et m_tabVue.
+ * @param enr L'enregistrement
+ * @param noTick Numro du tick, comme m_noTick sur le PIC (le "tick" d'un
+ * dpassement de la commande 'J', voir moniteur.h)
+ * @param tick Reoit ce qu'a fait le tick
+ * @return faux si le tick n'est pas dans l'enregistrement
+ */
+bool carte_rejoueTick(const Enregistrement* enr, unsigned long noTick, TickRejoue* tick);
+
+#endif	/* CARTE_H */
@@ -0,0 +1,344 @@
+/**
+ * @file   charge.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Gnrateur de charge pour serveur.c: beaucoup de joueurs
+ * automatiques  la fois, chacun sur sa connexion.
+ *
+ * Usage: charge [-s socket] [-c connexions] [-n coups] [-b lot]
+ *  -s  chemin du socket du serveur (demineur.sock par dfaut)
+ *  -c  connexions simultanes (1000 par dfaut)
+ *  -n  coups jous au total (200000 par dfaut)
+ *  -b  coups par commande 'B' (0 par dfaut: une commande 'D' ou 'M' par
+ *      coup)
+ *
+ * Chaque connexion charge d'abord un champ tir au hasard avec 'L' et
+ * vrifie le hachage rpondu (masque_hacheChamp(), calcul ici sur le mme
+ * masque): chaque session joue bien son propre champ. Elle joue ensuite des
+ * coups au hasard (un drapeau pour six clics), une requte  la fois, et
+ * vrifie chaque octet de rponse: 'C', 'G' ou 'P' par coup, puis la vue
+ * pour 'B'. Un seul fil attend toutes les connexions sur epoll.
+ *
+ * La latence d'une requte va de l'envoi  la fin de sa rponse. Une ligne
+ * JSON  la fin:
+ *  {"charge":"fin","connexions":..,"lot":..,"coups":..,"requetes":..,
+ *   "duree_s":..,"coups_par_s":..,"latence_us":{"p50":..,"p99":..,
+ *   "p999":..,"max":..},"erreurs":..}
+ * Le code de sortie est 1 si une rponse tait fausse.
+ */
+
+#define _GNU_SOURCE //SOCK_CLOEXEC
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include "../demineur.h"
+#include "../masque.h"
+
+#define SOCKET_DEFAUT "demineur.sock"
+#define CONNEXIONS_DEFAUT 1000
+#define COUPS_DEFAUT 200000
+#define MINES_CHAMP 12 //mines des champs chargs avec 'L'
+#define DRAPEAU_UN_SUR 7 //un coup sur 7 est un drapeau
+#define ESSAIS_CONNEXION 200 //le serveur vient peut-tre d'tre lanc: 200 x 10 ms
+#define NB_EVENEMENTS 256
+#define TAILLE_REPONSE 1024 //la plus longue: 255 rsultats et la vue
+
+/*
+ * Un joueur automatique et sa requte en cours.
+ */
+typedef struct {
+    int socket;
+    uint64_t alea; //tat xorshift64*
+    bool charge; //vrai pendant le chargement du champ
+    unsigned char attendu[TAILLE_REPONSE]; //rponse 'L' attendue
+    size_t nbAttendus, nbRecus; //octets de la rponse en cours
+    unsigned int nbResultats; //octets de rsultats avant la vue
+    double debut; //envoi de la requte, en secondes
+} Connexion;
+
+static long m_nbRestants; //coups pas encore envoys
+static long m_nbRequetes;
+static double* m_latences; //en microsecondes, une par requte de coups
+static long m_nbErreurs;
+static unsigned int m_lot;
+
+static int charge_connecte(const char* chemin);
+static void charge_charge(Connexion* connexion);
+static bool charge_joue(Connexion* connexion);
+static void charge_recoit(Connexion* connexion);
+static bool charge_octetValide(const Connexion* connexion, unsigned char octet);
+static void charge_envoie(Connexion* connexion, const unsigned char* octets, size_t nb);
+static uint64_t charge_alea(Connexion* connexion);
+static int charge_compare(const void* a, const void* b);
+static double charge_maintenant(void);
+
+int main(int argc, char** argv)
+{
+    const char* chemin = SOCKET_DEFAUT;
+    long nbConnexions = CONNEXIONS_DEFAUT, nbCoups = COUPS_DEFAUT;
+    struct epoll_event evenements[NB_EVENEMENTS];
+    struct epoll_event evenement = {.events = EPOLLIN};
+    Connexion* connexions;
+    long nbActives;
+    double debut, duree;
+    int epoll, nb, opt;
+
+    while ((opt = getopt(argc, argv, "s:c:n:b:")) != -1) {
+        switch (opt) {
+            case 's':
+                chemin = optarg;
+                break;
+            case 'c':
+                nbConnexions = atol(optarg);
+                break;
+            case 'n':
+                nbCoups = atol(optarg);
+                break;
+            case 'b':
+                m_lot = atoi(optarg);
+                break;
+            default:
+                fprintf(stderr, "usage: charge [-s socket] [-c connexions] [-n coups] [-b lot]\n");
+                return 2;
+        }
+    }
+    if (nbConnexions < 1 || nbCoups < 1 || m_lot > 255) {
+        fprintf(stderr, "charge: options invalides\n");
+        return 2;
+    }
+    m_nbRestants = nbCoups;
+    connexions = calloc(nbConnexions, sizeof *connexions);
+    m_latences = malloc(nbCoups * sizeof *m_latences); //au plus une requte par coup
+    epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (connexions == NULL || m_latences == NULL || epoll < 0) {
+        fprintf(stderr, "charge: memoire insuffisante\n");
+        return 1;
+    }
+
+    debut = charge_maintenant();
+    for (long i = 0; i < nbConnexions; i++) {
+        connexions[i].socket = charge_connecte(chemin);
+        if (connexions[i].socket < 0) {
+            perror(chemin);
+            return 1;
+        }
+        connexions[i].alea = 0x9E3779B97F4A7C15u * (i + 1);
+        evenement.data.ptr = &connexions[i];
+        epoll_ctl(epoll, EPOLL_CTL_ADD, connexions[i].socket, &evenement);
+        charge_charge(&connexions[i]);
+    }
+    nbActives = nbConnexions;
+    while (nbActives > 0) {
+        nb = epoll_wait(epoll, evenements, NB_EVENEMENTS, -1);
+        for (int i = 0; i < nb; i++) {
+            Connexion* connexion = evenements[i].data.ptr;
+
+            charge_recoit(connexion);
+            if (connexion->nbRecus < connexion->nbAttendus)
+                continue; //rponse incomplte
+            if (!charge_joue(connexion)) { //plus de coups  jouer
+                close(connexion->socket);
+                nbActives--;
+            }
+        }
+    }
+    duree = charge_maintenant() - debut;
+
+    qsort(m_latences, m_nbRequetes, sizeof *m_latences, charge_compare);
+    printf("{\"charge\":\"fin\",\"connexions\":%ld,\"lot\":%u,\"coups\":%ld,\"requetes\":%ld,"
+            "\"duree_s\":%.3f,\"coups_par_s\":%.0f,\"latence_us\":{\"p50\":%.1f,\"p99\":%.1f,"
+            "\"p999\":%.1f,\"max\":%.1f},\"erreurs\":%ld}\n",
+            nbConnexions, m_lot, nbCoups, m_nbRequetes, duree, nbCoups / duree,
+            m_latences[m_nbRequetes / 2], m_latences[m_nbRequetes * 99 / 100],
+            m_latences[m_nbRequetes * 999 / 1000], m_latences[m_nbRequetes - 1], m_nbErreurs);
+    return m_nbErreurs == 0 ? 0 : 1;
+}
+
+/*
+ * @brief Se connecte au serveur, en ressayant pendant qu'il dmarre.
+ * @param const char* chemin Le chemin du socket
+ * @return le socket, ou -1
+ */
+static int charge_connecte(const char* chemin)
+{
+    struct sockaddr_un adresse = {.sun_family = AF_UNIX};
+    struct timespec attente = {0, 10000000};
+    int client;
+
+    strncpy(adresse.sun_path, chemin, sizeof adresse.sun_path - 1);
+    for (int essai = 0; essai < ESSAIS_CONNEXION; essai++) {
+        client = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (client < 0)
+            return -1;
+        if (connect(client, (struct sockaddr*) &adresse, sizeof adresse) == 0)
+            return client;
+        close(client);
+        if (errno != ENOENT && errno != ECONNREFUSED)
+            return -1;
+        nanosleep(&attente, NULL);
+    }
+    return -1;
+}
+
+/*
+ * @brief Envoie un champ tir au hasard ('L') et prpare la rponse
+ * attendue, "OK hhhh\r\n" avec le hachage du champ.
+ * @param Connexion* connexion La connexion
+ * @return rien
+ */
+static void charge_charge(Connexion* connexion)
+{
+    unsigned char trame[NB_OCTETS_MASQUE + 2] = {'L'};
+    unsigned char* masque = trame + 1;
+    unsigned int k;
+
+    for (int m = 0; m < MINES_CHAMP; m++) {
+        do
+            k = charge_alea(connexion) % NB_CASES;
+        while (masque[k / 8] & (1 << (k % 8)));
+        masque[k / 8] |= 1 << (k % 8);
+    }
+    trame[NB_OCTETS_MASQUE + 1] = masque_crc8(masque, NB_OCTETS_MASQUE);
+    masque_decompacte(masque); //le hachage est calcul sur m_tabMines
+    connexion->nbAttendus = snprintf((char*) connexion->attendu, TAILLE_REPONSE, "OK %04X\r\n", masque_hacheChamp());
+    connexion->nbRecus = 0;
+    connexion->charge = true;
+    connexion->debut = charge_maintenant();
+    charge_envoie(connexion, trame, sizeof trame);
+}
+
+/*
+ * @brief Envoie la requte de coups suivante: un coup 'D' ou 'M', ou un
+ * lot 'B' de m_lot coups.
+ * @param Connexion* connexion La connexion dont la rponse est complte
+ * @return faux s'il n'y a plus de coups  jouer
+ */
+static bool charge_joue(Connexion* connexion)
+{
+    unsigned char requete[2 + 3 * 255];
+    unsigned int nbCoups = m_lot == 0 ? 1 : m_lot;
+    unsigned char* coup = requete;
+    size_t longueur;
+
+    if (!connexion->charge)
+        m_latences[m_nbRequetes++] = (charge_maintenant() - connexion->debut) * 1e6;
+    connexion->charge = false;
+    if (m_nbRestants == 0)
+        return false;
+    if (nbCoups > m_nbRestants)
+        nbCoups = m_nbRestants;
+    m_nbRestants -= nbCoups;
+    if (m_lot != 0) {
+        requete[0] = 'B';
+        requete[1] = nbCoups;
+        coup = requete + 2;
+    }
+    for (unsigned int i = 0; i < nbCoups; i++, coup += 3) {
+        coup[0] = charge_alea(connexion) % DRAPEAU_UN_SUR == 0 ? 'M' : 'D';
+        coup[1] = 1 + charge_alea(connexion) % NB_COL;
+        coup[2] = 1 + charge_alea(connexion) % NB_LIGNE;
+    }
+    longueur = coup - requete;
+    connexion->nbResultats = nbCoups;
+    connexion->nbAttendus = nbCoups + (m_lot != 0 ? NB_CASES : 0);
+    connexion->nbRecus = 0;
+    connexion->debut = charge_maintenant();
+    charge_envoie(connexion, requete, longueur);
+    return true;
+}
+
+/*
+ * @brief Lit ce qui est arriv de la rponse en cours et vrifie chaque
+ * octet. Le serveur ne rpond qu' la requte en cours: rien n'arrive au
+ * del de nbAttendus.
+ * @param Connexion* connexion La connexion
+ * @return rien
+ */
+static void charge_recoit(Connexion* connexion)
+{
+    unsigned char octets[TAILLE_REPONSE];
+    ssize_t nb = recv(connexion->socket, octets, connexion->nbAttendus - connexion->nbRecus, MSG_DONTWAIT);
+
+    if (nb == 0) {
+        fprintf(stderr, "charge: connexion fermee par le serveur\n");
+        exit(1);
+    }
+    for (ssize_t i = 0; i < nb; i++) {
+        if (!charge_octetValide(connexion, octets[i]))
+            m_nbErreurs++;
+        connexion->nbRecus++;
+    }
+}
+
+/*
+ * @brief Vrifie l'octet suivant de la rponse en cours.
+ * @param const Connexion* connexion La connexion, nbRecus pas encore avanc
+ * @param unsigned char octet L'octet reu
+ * @return vrai si l'octet est possible  cette place
+ */
+static bool charge_octetValide(const Connexion* connexion, unsigned char octet)
+{
+    if (connexion->charge)
+        return octet == connexion->attendu[connexion->nbRecus];
+    if (connexion->nbRecus < connexion->nbResultats)
+        return octet == PARTIE_EN_COURS || octet == PARTIE_GAGNEE || octet == PARTIE_PERDUE;
+    return octet == TUILE || octet == DRAPEAU || octet == ' ' || (octet >= '1' && octet <= '8'); //vue d'une partie en cours
+}
+
+/*
+ * @brief Envoie une requte entire. Le socket est bloquant; une requte
+ * tient dans le tampon d'envoi.
+ * @param Connexion* connexion La connexion
+ * @param const unsigned char* octets, size_t nb La requte
+ * @return rien
+ */
+static void charge_envoie(Connexion* connexion, const unsigned char* octets, size_t nb)
+{
+    if (send(connexion->socket, octets, nb, MSG_NOSIGNAL) != (ssize_t) nb) {
+        perror("charge");
+        exit(1);
+    }
+}
+
+/*
+ * @brief Nombre pseudo-alatoire de 64 bits (xorshift64*), une suite par
+ * connexion.
+ * @param Connexion* connexion La connexion
+ * @return le nombre
+ */
+static uint64_t charge_alea(Connexion* connexion)
+{
+    connexion->alea ^= connexion->alea >> 12;
+    connexion->alea ^= connexion->alea << 25;
+    connexion->alea ^= connexion->alea >> 27;
+    return (connexion->alea * 0x2545F4914F6CDD1Du) >> 32;
+}
+
+/*
+ * @brief Ordre croissant des latences, pour qsort().
+ */
+static int charge_compare(const void* a, const void* b)
+{
+    double da = *(const double*) a, db = *(const double*) b;
+
+    return (da > db) - (da < db);
+}
+
+/*
+ * @brief Temps monotone en secondes.
+ * @param rien
+ * @return le temps
+ */
+static double charge_maintenant(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
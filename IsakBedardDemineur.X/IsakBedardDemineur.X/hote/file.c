@@ -0,0 +1,129 @@
+/**
+ * @file   file.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  File borne sans verrou. Voir file.h.
+ *
+ * La place p (modulo la capacit) est libre pour l'criture numro n quand
+ * sa squence vaut n, et prte pour la lecture numro n quand elle vaut
+ * n + 1. Le fil qui gagne le compare-and-swap sur la position a la place 
+ * lui seul; il la publie ensuite en avanant sa squence (release), que
+ * l'autre ct lit avec acquire avant de copier l'lment.
+ */
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "file.h"
+
+#define LIGNE_CACHE 64 //les deux positions sur des lignes de cache diffrentes
+
+struct File {
+    _Alignas(LIGNE_CACHE) atomic_size_t ecriture; //prochaine criture
+    _Alignas(LIGNE_CACHE) atomic_size_t lecture; //prochaine lecture
+    _Alignas(LIGNE_CACHE) size_t masque; //capacit - 1
+    size_t taille; //octets par lment
+    atomic_size_t* sequences; //une par place
+    unsigned char* elements; //capacit * taille octets
+};
+
+/*
+ * @brief Alloue une file vide. Voir file.h.
+ * @param size_t capacite, size_t taille Voir file.h
+ * @return la file, NULL si la mmoire manque
+ */
+File* file_cree(size_t capacite, size_t taille)
+{
+    File* file = aligned_alloc(LIGNE_CACHE, sizeof(File));
+    size_t nb = 2;
+
+    while (nb < capacite)
+        nb *= 2;
+    if (file == NULL)
+        return NULL;
+    file->sequences = malloc(nb * sizeof(atomic_size_t));
+    file->elements = malloc(nb * taille);
+    if (file->sequences == NULL || file->elements == NULL) {
+        file_detruit(file);
+        return NULL;
+    }
+    for (size_t i = 0; i < nb; i++)
+        atomic_init(&file->sequences[i], i);
+    atomic_init(&file->ecriture, 0);
+    atomic_init(&file->lecture, 0);
+    file->masque = nb - 1;
+    file->taille = taille;
+    return file;
+}
+
+/*
+ * @brief Libre une file. Voir file.h.
+ * @param File* file La file
+ * @return rien
+ */
+void file_detruit(File* file)
+{
+    if (file == NULL)
+        return;
+    free(file->sequences);
+    free(file->elements);
+    free(file);
+}
+
+/*
+ * @brief Ajoute un lment. Voir file.h.
+ * @param File* file, const void* element Voir file.h
+ * @return faux si la file est pleine
+ */
+bool file_ajoute(File* file, const void* element)
+{
+    size_t position = atomic_load_explicit(&file->ecriture, memory_order_relaxed);
+    size_t sequence;
+    intptr_t ecart;
+
+    for (;;) {
+        sequence = atomic_load_explicit(&file->sequences[position & file->masque], memory_order_acquire);
+        ecart = (intptr_t) sequence - (intptr_t) position;
+        if (ecart == 0) { //place libre: on essaie de la prendre
+            if (atomic_compare_exchange_weak_explicit(&file->ecriture, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (ecart < 0) //la place n'a pas encore t lue: un tour complet d'avance
+            return false;
+        else //un autre fil a pris la place
+            position = atomic_load_explicit(&file->ecriture, memory_order_relaxed);
+    }
+    memcpy(file->elements + (position & file->masque) * file->taille, element, file->taille);
+    atomic_store_explicit(&file->sequences[position & file->masque], position + 1, memory_order_release);
+    return true;
+}
+
+/*
+ * @brief Retire un lment. Voir file.h.
+ * @param File* file, void* element Voir file.h
+ * @return faux si la file est vide
+ */
+bool file_retire(File* file, void* element)
+{
+    size_t position = atomic_load_explicit(&file->lecture, memory_order_relaxed);
+    size_t sequence;
+    intptr_t ecart;
+
+    for (;;) {
+        sequence = atomic_load_explicit(&file->sequences[position & file->masque], memory_order_acquire);
+        ecart = (intptr_t) sequence - (intptr_t) (position + 1);
+        if (ecart == 0) { //lment publi: on essaie de le prendre
+            if (atomic_compare_exchange_weak_explicit(&file->lecture, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (ecart < 0) //pas encore crit
+            return false;
+        else
+            position = atomic_load_explicit(&file->lecture, memory_order_relaxed);
+    }
+    memcpy(element, file->elements + (position & file->masque) * file->taille, file->taille);
+    atomic_store_explicit(&file->sequences[position & file->masque], position + file->masque + 1,
+                          memory_order_release);
+    return true;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file   file.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  File borne sans verrou entre fils d'excution, pour les outils
+ * de l'ordinateur (generation.c, serveur.c).
+ *
+ * Plusieurs fils peuvent ajouter et retirer en mme temps (file de Vyukov:
+ * chaque place a un numro de squence, les positions de lecture et
+ * d'criture avancent par compare-and-swap). Les lments ont tous la mme
+ * taille et sont copis dans la file: aucune allocation aprs file_cree().
+ * Une file pleine ou vide ne bloque pas: l'appelant dcide d'attendre.
+ */
+
+#ifndef FILE_H
+#define	FILE_H
+
+#include <stdbool.h>  // pour l'utilisation du type bool
+#include <stddef.h>
+
+typedef struct File File;
+
+/**
+ * @brief Alloue une file vide.
+ * @param capacite Nombre de places, arrondi  la puissance de 2 suprieure
+ * @param taille Taille d'un lment en octets
+ * @return la file, NULL si la mmoire manque
+ */
+File* file_cree(size_t capacite, size_t taille);
+
+/**
+ * @brief Libre une file. Aucun fil ne doit plus l'utiliser.
+ * @param file La file
+ */
+void file_detruit(File* file);
+
+/**
+ * @brief Copie un lment  la fin de la file.
+ * @param file La file
+ * @param element L'lment, taille octets
+ * @return faux si la file est pleine (rien n'est copi)
+ */
+bool file_ajoute(File* file, const void* element);
+
+/**
+ * @brief Retire le premier lment de la file.
+ * @param file La file
+ * @param element Reoit l'lment, taille octets
+ * @return faux si la file est vide
+ */
+bool file_retire(File* file, void* element);
+
+#endif	/* FILE_H */
@@ -0,0 +1,650 @@
+/**
+ * @file   geant.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Champs gants (10^8  10^9 cases) sur disque, pour les essais de
+ * charge sur l'ordinateur.
+ *
+ * Usage: geant [lignes] [colonnes] [densit en %] [lignes par tuile]
+ *        (10000 x 10000, 5 %, tuiles d'environ CASES_PAR_TUILE cases par dfaut)
+ *        geant -v   vrifie le mode gant contre regles.c et un remplissage en mmoire
+ *
+ * Le champ est dans deux fichiers au format du masque (masque.h, commande 'L'),
+ * avec un nombre de colonnes quelconque: la case (ligne, colonne) est le bit
+ * (k % 8) de l'octet k / 8, o k = ligne * colonnes + colonne.
+ *  - geant.mines: 1 pour une mine;
+ *  - geant.vue: 1 pour une case dvoile.
+ * Les cases ont le sens de m_tabMines et m_tabVue: une case vaut MINE, ' ' ou
+ * un chiffre, calcul  partir des mines voisines; une case de la vue vaut
+ * TUILE tant que son bit est  0, puis la valeur de la case. Il n'y a pas de
+ * drapeaux.
+ *
+ * Le champ est dcoup en tuiles de lignes entires. Chaque tape passe les
+ * tuiles une  une: elle projette (mmap) les lignes de la tuile et une ligne
+ * de chaque ct, puis libre la projection avant la tuile suivante. Seule
+ * une tuile est donc en mmoire, quelle que soit la taille du champ:
+ *  - placement: exactement mines = cases * densit, par slection
+ *    squentielle (chaque case est une mine avec la probabilit
+ *    mines restantes / cases restantes);
+ *  - chiffres: sommes par colonne sur trois lignes, comme metToucheCombien();
+ *  - dvoilement: depuis la premire case vide  partir de la ligne du
+ *    milieu, une case vide dvoile son 3x3 et chaque case vide dvoile
+ *    continue. Une tuile qui dvoile une case de la ligne d'une voisine
+ *    ractive cette voisine; on repasse les tuiles actives jusqu' ce qu'il
+ *    n'y en ait plus.
+ * Rponse (une ligne JSON):
+ *  {"lignes":..,"colonnes":..,"cases":..,"mines":..,"lignes_par_tuile":..,"tuiles":..,
+ *   "placement":{"s":..,"cases_par_s":..},
+ *   "chiffres":{"s":..,"cases_par_s":..,"histogramme":[vides,1,..,8]},
+ *   "devoilement":{"s":..,"cases_par_s":..,"devoilees":..,"passages":..},
+ *   "octets_fichiers":..,"rss_max_ko":..}
+ * o cases_par_s est le nombre de cases du champ par seconde (dvoilement:
+ * cases dvoiles par seconde), passages le nombre de tuiles traites par le
+ * dvoilement et rss_max_ko la mmoire rsidente maximale du processus.
+ */
+
+#define _DEFAULT_SOURCE //mmap(), getrusage(), clock_gettime()
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include "../demineur.h"
+#include "../masque.h"
+
+#define CASES_PAR_TUILE (1UL << 22) //environ 512 Ko de bits par fichier et par tuile
+#define FICHIER_MINES "geant.mines"
+#define FICHIER_VUE "geant.vue"
+#define VIDE 9 //case vide pas encore dvoile, dans la vrification en mmoire
+
+/**
+ * Un fichier du champ et la projection en cours d'une partie de ses lignes.
+ */
+typedef struct {
+    int fd;
+    unsigned char* base; //dbut de la projection, NULL si rien n'est projet
+    size_t taille; //taille de la projection, en octets
+    uint64_t debut; //numro dans le fichier du premier octet projet
+} Fichier;
+
+/**
+ * Le champ gant.
+ */
+typedef struct {
+    uint64_t nbLignes, nbCol;
+    uint64_t lignesParTuile, nbTuiles;
+    Fichier mines, vue;
+} Champ;
+
+static uint64_t m_alea = 88172645463325252ULL; //tat du gnrateur xorshift64*
+
+static bool geant_ouvre(Champ* c, uint64_t nbLignes, uint64_t nbCol, uint64_t lignesParTuile);
+static void geant_ferme(Champ* c);
+static void geant_projette(const Champ* c, Fichier* f, int64_t premiere, int64_t fin);
+static void geant_libere(Fichier* f);
+static uint64_t geant_place(Champ* c, uint64_t nbMines);
+static bool geant_chiffres(Champ* c, uint64_t histogramme[9], uint64_t* vide);
+static uint64_t geant_devoile(Champ* c, uint64_t depart, uint64_t* nbPassages);
+static uint64_t geant_passeTuile(Champ* c, uint64_t t, uint64_t depart, bool* actives, uint32_t* pile);
+static int geant_compte(const Champ* c, uint64_t ligne, uint64_t colonne);
+static char geant_case(const Champ* c, uint64_t ligne, uint64_t colonne);
+static void geant_litLigne(const Champ* c, int64_t ligne, char* dest);
+static int geant_verifie(void);
+static bool geant_verifieRegles(void);
+static bool geant_verifieDevoilement(uint64_t nbLignes, uint64_t nbCol, int densite, uint64_t lignesParTuile);
+static uint64_t geant_alea(void);
+static double geant_maintenant(void);
+
+static inline bool geant_bit(const Fichier* f, uint64_t k)
+{
+    return (f->base[(k >> 3) - f->debut] >> (k & 7)) & 1;
+}
+
+static inline void geant_metBit(Fichier* f, uint64_t k)
+{
+    f->base[(k >> 3) - f->debut] |= 1 << (k & 7);
+}
+
+int main(int argc, char** argv)
+{
+    Champ c;
+    uint64_t nbLignes, nbCol, nbCases, nbMines, lignesParTuile, depart;
+    uint64_t histogramme[9], nbDevoilees = 0, nbPassages = 0;
+    double densite, debut, placement, chiffres, devoilement = 0;
+    struct rusage usage;
+    bool trouve;
+
+    if (argc > 1 && strcmp(argv[1], "-v") == 0)
+        return geant_verifie();
+    nbLignes = (argc > 1) ? strtoull(argv[1], NULL, 10) : 10000;
+    nbCol = (argc > 2) ? strtoull(argv[2], NULL, 10) : 10000;
+    densite = (argc > 3) ? atof(argv[3]) / 100 : 0.05;
+    lignesParTuile = (argc > 4) ? strtoull(argv[4], NULL, 10) : 0;
+    if (nbLignes < 1 || nbCol < 1 || densite < 0 || densite > 1) {
+        fprintf(stderr, "usage: geant [lignes] [colonnes] [densite en %%] [lignes par tuile] | -v\n");
+        return 2;
+    }
+    if (lignesParTuile < 1)
+        lignesParTuile = (CASES_PAR_TUILE / nbCol > 0) ? CASES_PAR_TUILE / nbCol : 1;
+    nbCases = nbLignes * nbCol;
+    nbMines = (uint64_t) (nbCases * densite);
+    if (!geant_ouvre(&c, nbLignes, nbCol, lignesParTuile))
+        return 1;
+
+    debut = geant_maintenant();
+    geant_place(&c, nbMines);
+    placement = geant_maintenant() - debut;
+
+    debut = geant_maintenant();
+    trouve = geant_chiffres(&c, histogramme, &depart);
+    chiffres = geant_maintenant() - debut;
+
+    if (trouve) { //un champ sans case vide n'a rien  dvoiler
+        debut = geant_maintenant();
+        nbDevoilees = geant_devoile(&c, depart, &nbPassages);
+        devoilement = geant_maintenant() - debut;
+    }
+    getrusage(RUSAGE_SELF, &usage);
+
+    printf("{\"lignes\":%llu,\"colonnes\":%llu,\"cases\":%llu,\"mines\":%llu,"
+           "\"lignes_par_tuile\":%llu,\"tuiles\":%llu",
+           (unsigned long long) nbLignes, (unsigned long long) nbCol, (unsigned long long) nbCases,
+           (unsigned long long) nbMines, (unsigned long long) lignesParTuile,
+           (unsigned long long) c.nbTuiles);
+    printf(",\"placement\":{\"s\":%.3f,\"cases_par_s\":%.0f}", placement, nbCases / placement);
+    printf(",\"chiffres\":{\"s\":%.3f,\"cases_par_s\":%.0f,\"histogramme\":[", chiffres, nbCases / chiffres);
+    for (int n = 0; n < 9; n++)
+        printf("%s%llu", n ? "," : "", (unsigned long long) histogramme[n]);
+    printf("]},\"devoilement\":{\"s\":%.3f,\"cases_par_s\":%.0f,\"devoilees\":%llu,\"passages\":%llu}",
+           devoilement, devoilement > 0 ? nbDevoilees / devoilement : 0,
+           (unsigned long long) nbDevoilees, (unsigned long long) nbPassages);
+    printf(",\"octets_fichiers\":%llu,\"rss_max_ko\":%ld}\n",
+           (unsigned long long) (2 * ((nbCases + 7) / 8)), usage.ru_maxrss);
+    geant_ferme(&c);
+    return 0;
+}
+
+/*
+ * @brief Cre les deux fichiers du champ, remplis de 0 (aucune mine, tout
+ * est couvert). Les fichiers sont creux: rien n'est crit ici.
+ * @param c Le champ
+ * @param nbLignes, nbCol Taille du champ
+ * @param lignesParTuile Hauteur d'une tuile
+ * @return vrai si les fichiers sont prts
+ */
+static bool geant_ouvre(Champ* c, uint64_t nbLignes, uint64_t nbCol, uint64_t lignesParTuile)
+{
+    off_t taille = (off_t) ((nbLignes * nbCol + 7) / 8);
+
+    c->nbLignes = nbLignes;
+    c->nbCol = nbCol;
+    c->lignesParTuile = lignesParTuile;
+    c->nbTuiles = (nbLignes + lignesParTuile - 1) / lignesParTuile;
+    c->mines.fd = open(FICHIER_MINES, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    c->vue.fd = open(FICHIER_VUE, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    c->mines.base = NULL;
+    c->vue.base = NULL;
+    if (c->mines.fd < 0 || c->vue.fd < 0
+        || ftruncate(c->mines.fd, taille) != 0 || ftruncate(c->vue.fd, taille) != 0) {
+        perror("geant");
+        geant_ferme(c);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * @brief Ferme et efface les fichiers du champ.
+ * @param c Le champ
+ * @return rien
+ */
+static void geant_ferme(Champ* c)
+{
+    geant_libere(&c->mines);
+    geant_libere(&c->vue);
+    if (c->mines.fd >= 0)
+        close(c->mines.fd);
+    if (c->vue.fd >= 0)
+        close(c->vue.fd);
+    unlink(FICHIER_MINES);
+    unlink(FICHIER_VUE);
+}
+
+/*
+ * @brief Projette en mmoire les lignes [premiere, fin[ d'un fichier du
+ * champ, bornes au champ. Libre la projection prcdente.
+ * @param c Le champ
+ * @param f c->mines ou c->vue
+ * @param premiere, fin Les lignes  projeter
+ * @return rien
+ */
+static void geant_projette(const Champ* c, Fichier* f, int64_t premiere, int64_t fin)
+{
+    uint64_t page = (uint64_t) sysconf(_SC_PAGESIZE);
+    uint64_t premierOctet, finOctet;
+
+    geant_libere(f);
+    if (premiere < 0)
+        premiere = 0;
+    if (fin > (int64_t) c->nbLignes)
+        fin = c->nbLignes;
+    premierOctet = ((uint64_t) premiere * c->nbCol >> 3) / page * page; //mmap() part d'une page
+    finOctet = ((uint64_t) fin * c->nbCol + 7) >> 3;
+    f->debut = premierOctet;
+    f->taille = finOctet - premierOctet;
+    f->base = mmap(NULL, f->taille, PROT_READ | PROT_WRITE, MAP_SHARED, f->fd, (off_t) premierOctet);
+    if (f->base == MAP_FAILED) {
+        perror("geant: mmap");
+        exit(1);
+    }
+}
+
+/*
+ * @brief Libre la projection en cours d'un fichier. Les pages modifies
+ * restent dans le fichier.
+ * @param f c->mines ou c->vue
+ * @return rien
+ */
+static void geant_libere(Fichier* f)
+{
+    if (f->base != NULL)
+        munmap(f->base, f->taille);
+    f->base = NULL;
+}
+
+/*
+ * @brief Place exactement nbMines mines, tuile par tuile. Chaque case est une
+ * mine avec la probabilit mines restantes / cases restantes: toutes les
+ * dispositions ont la mme probabilit, sans jamais revenir en arrire.
+ * @param c Le champ, sans mines
+ * @param nbMines Le nombre de mines, au plus le nombre de cases
+ * @return le nombre de mines places (nbMines)
+ */
+static uint64_t geant_place(Champ* c, uint64_t nbMines)
+{
+    uint64_t reste = nbMines;
+    uint64_t nbCases = c->nbLignes * c->nbCol;
+    uint64_t k = 0, fin;
+
+    for (uint64_t t = 0; t < c->nbTuiles; t++) {
+        geant_projette(c, &c->mines, t * c->lignesParTuile, (t + 1) * c->lignesParTuile);
+        fin = (t + 1) * c->lignesParTuile * c->nbCol;
+        if (fin > nbCases)
+            fin = nbCases;
+        for (; k < fin && reste > 0; k++) {
+            if ((geant_alea() >> 11) * 0x1p-53 * (nbCases - k) < reste) {
+                geant_metBit(&c->mines, k);
+                reste--;
+            }
+        }
+        k = fin;
+    }
+    geant_libere(&c->mines);
+    return nbMines - reste;
+}
+
+/*
+ * @brief Calcule le chiffre de chaque case, tuile par tuile, comme
+ * metToucheCombien(): pour chaque ligne, on additionne par colonne les mines
+ * des lignes du dessus, du centre et du dessous, puis une case touche  la
+ * somme de sa colonne et des deux colonnes voisines. Les chiffres ne sont pas
+ * gards (geant_case() les recalcule): seul l'histogramme est rendu.
+ * @param c Le champ
+ * @param histogramme Reoit le nombre de cases sans mine par chiffre (0 = vide)
+ * @param vide Reoit la premire case vide  partir de la ligne du milieu
+ * @return vrai si une telle case existe
+ */
+static bool geant_chiffres(Champ* c, uint64_t histogramme[9], uint64_t* vide)
+{
+    size_t largeur = c->nbCol + 2; //une colonne vide de chaque ct
+    char* lignes = malloc(3 * largeur);
+    char* colonnes = malloc(largeur);
+    char *dessus, *centre, *dessous, *tmp;
+    uint64_t debut, fin, milieu = c->nbLignes / 2;
+    bool trouve = false;
+    int nb;
+
+    memset(histogramme, 0, 9 * sizeof histogramme[0]);
+    for (uint64_t t = 0; t < c->nbTuiles; t++) {
+        debut = t * c->lignesParTuile;
+        fin = (debut + c->lignesParTuile < c->nbLignes) ? debut + c->lignesParTuile : c->nbLignes;
+        geant_projette(c, &c->mines, (int64_t) debut - 1, fin + 1);
+        dessus = lignes;
+        centre = lignes + largeur;
+        dessous = lignes + 2 * largeur;
+        geant_litLigne(c, (int64_t) debut - 1, dessus);
+        geant_litLigne(c, debut, centre);
+        for (uint64_t i = debut; i < fin; i++) {
+            geant_litLigne(c, i + 1, dessous);
+            for (size_t j = 0; j < largeur; j++)
+                colonnes[j] = dessus[j] + centre[j] + dessous[j];
+            for (uint64_t j = 1; j <= c->nbCol; j++) {
+                if (centre[j])
+                    continue; //une mine n'a pas de chiffre
+                nb = colonnes[j - 1] + colonnes[j] + colonnes[j + 1];
+                histogramme[nb]++;
+                if (nb == 0 && !trouve && i >= milieu) {
+                    *vide = i * c->nbCol + j - 1;
+                    trouve = true;
+                }
+            }
+            tmp = dessus; //les lignes montent d'un cran
+            dessus = centre;
+            centre = dessous;
+            dessous = tmp;
+        }
+    }
+    geant_libere(&c->mines);
+    free(lignes);
+    free(colonnes);
+    return trouve;
+}
+
+/*
+ * @brief Dvoile la case depart, qui doit tre vide, et toute la zone vide
+ * qui la contient avec sa bordure de chiffres.
+ * @param c Le champ, vue toute couverte
+ * @param depart La case vide, k = ligne * colonnes + colonne
+ * @param nbPassages Reoit le nombre de tuiles traites
+ * @return le nombre de cases dvoiles
+ */
+static uint64_t geant_devoile(Champ* c, uint64_t depart, uint64_t* nbPassages)
+{
+    bool* actives = calloc(c->nbTuiles, sizeof(bool));
+    uint32_t* pile = malloc(c->lignesParTuile * c->nbCol * sizeof(uint32_t)); //une entre par case de la tuile
+    uint64_t t = depart / c->nbCol / c->lignesParTuile;
+    uint64_t nbDevoilees = 1;
+    bool encore = true;
+
+    geant_projette(c, &c->vue, depart / c->nbCol, depart / c->nbCol + 1);
+    geant_metBit(&c->vue, depart);
+    actives[t] = true;
+    *nbPassages = 0;
+    while (encore) { //on repasse les tuiles tant qu'une tuile voisine en a ractiv une
+        encore = false;
+        for (t = 0; t < c->nbTuiles; t++) {
+            if (actives[t]) {
+                actives[t] = false;
+                nbDevoilees += geant_passeTuile(c, t, depart, actives, pile);
+                (*nbPassages)++;
+                encore = true;
+            }
+        }
+    }
+    geant_libere(&c->mines);
+    geant_libere(&c->vue);
+    free(pile);
+    free(actives);
+    return nbDevoilees;
+}
+
+/*
+ * @brief Dvoile tout ce qui peut l'tre dans une tuile: chaque case vide
+ * dvoile de la tuile dvoile son 3x3. Les cases dvoiles dans la ligne
+ * d'une tuile voisine ractivent cette tuile. On part de la case de dpart
+ * et des cases vides dvoiles de la premire et de la dernire ligne: les
+ * autres ont dj dvoil leur 3x3  un passage prcdent, seules les
+ * tuiles voisines peuvent avoir dvoil des cases dans la tuile depuis.
+ * @param c Le champ
+ * @param t La tuile
+ * @param depart La case de dpart du dvoilement
+ * @param actives Les tuiles  repasser
+ * @param pile Une entre par case de la tuile
+ * @return le nombre de cases dvoiles
+ */
+static uint64_t geant_passeTuile(Champ* c, uint64_t t, uint64_t depart, bool* actives, uint32_t* pile)
+{
+    uint64_t debut = t * c->lignesParTuile;
+    uint64_t fin = (debut + c->lignesParTuile < c->nbLignes) ? debut + c->lignesParTuile : c->nbLignes;
+    uint64_t nbDevoilees = 0, k, ligne, colonne;
+    uint32_t nbPile = 0, p;
+
+    geant_projette(c, &c->mines, (int64_t) debut - 1, fin + 1); //les chiffres de la tuile
+    geant_projette(c, &c->vue, (int64_t) debut - 1, fin + 1); //et les lignes voisines  dvoiler
+    for (k = debut * c->nbCol; k < fin * c->nbCol; k++) {
+        if (k == (debut + 1) * c->nbCol && fin - debut > 2)
+            k = (fin - 1) * c->nbCol; //seulement la premire et la dernire ligne
+        if (geant_bit(&c->vue, k) && geant_compte(c, k / c->nbCol, k % c->nbCol) == 0)
+            pile[nbPile++] = (uint32_t) (k - debut * c->nbCol);
+    }
+    if (depart >= (debut + 1) * c->nbCol && depart < (fin - 1) * c->nbCol) //pas dj dans la pile
+        pile[nbPile++] = (uint32_t) (depart - debut * c->nbCol);
+    while (nbPile > 0) {
+        p = pile[--nbPile];
+        ligne = debut + p / c->nbCol;
+        colonne = p % c->nbCol;
+        for (uint64_t i = (ligne > 0) ? ligne - 1 : 0; i <= ligne + 1 && i < c->nbLignes; i++) {
+            for (uint64_t j = (colonne > 0) ? colonne - 1 : 0; j <= colonne + 1 && j < c->nbCol; j++) {
+                k = i * c->nbCol + j;
+                if (geant_bit(&c->vue, k))
+                    continue; //les voisines d'une case vide ne sont jamais des mines
+                geant_metBit(&c->vue, k);
+                nbDevoilees++;
+                if (i < debut)
+                    actives[t - 1] = true;
+                else if (i >= fin)
+                    actives[t + 1] = true;
+                else if (geant_compte(c, i, j) == 0)
+                    pile[nbPile++] = (uint32_t) (k - debut * c->nbCol);
+            }
+        }
+    }
+    return nbDevoilees;
+}
+
+/*
+ * @brief Compte les mines du 3x3 autour d'une case. Les lignes voisines
+ * doivent tre projetes.
+ * @param c Le champ
+ * @param ligne, colonne La case,  partir de 0
+ * @return le nombre de mines autour, la case comprise
+ */
+static int geant_compte(const Champ* c, uint64_t ligne, uint64_t colonne)
+{
+    int nb = 0;
+
+    for (uint64_t i = (ligne > 0) ? ligne - 1 : 0; i <= ligne + 1 && i < c->nbLignes; i++) {
+        for (uint64_t j = (colonne > 0) ? colonne - 1 : 0; j <= colonne + 1 && j < c->nbCol; j++)
+            nb += geant_bit(&c->mines, i * c->nbCol + j);
+    }
+    return nb;
+}
+
+/*
+ * @brief Valeur d'une case, comme dans m_tabMines.
+ * @param c Le champ
+ * @param ligne, colonne La case,  partir de 0
+ * @return MINE, ' ' ou le chiffre
+ */
+static char geant_case(const Champ* c, uint64_t ligne, uint64_t colonne)
+{
+    int nb;
+
+    if (geant_bit(&c->mines, ligne * c->nbCol + colonne))
+        return MINE;
+    nb = geant_compte(c, ligne, colonne);
+    return (nb == 0) ? ' ' : nb + '0';
+}
+
+/*
+ * @brief Copie une ligne de mines dans dest[1..colonnes] (1 pour une mine),
+ * avec une colonne vide de chaque ct. Une ligne hors du champ est vide.
+ * @param c Le champ, la ligne projete
+ * @param ligne La ligne
+ * @param dest colonnes + 2 octets
+ * @return rien
+ */
+static void geant_litLigne(const Champ* c, int64_t ligne, char* dest)
+{
+    uint64_t k;
+
+    memset(dest, 0, c->nbCol + 2);
+    if (ligne < 0 || ligne >= (int64_t) c->nbLignes)
+        return;
+    k = (uint64_t) ligne * c->nbCol;
+    for (uint64_t j = 1; j <= c->nbCol; j++, k++)
+        dest[j] = geant_bit(&c->mines, k);
+}
+
+/*
+ * @brief Vrifie le mode gant: chiffres contre regles.c sur NB_LIGNE x
+ * NB_COL, puis dvoilement contre un remplissage en mmoire, sur des champs
+ * dcoups en petites tuiles.
+ * @param rien
+ * @return 0 si tout est identique, 1  la premire diffrence
+ */
+static int geant_verifie(void)
+{
+    static const uint64_t tuiles[] = {1, 2, 3, 7, 64};
+    static const int densites[] = {2, 5, 10, 15, 20};
+    int nbChamps = 0;
+
+    for (int essai = 0; essai < 2000; essai++, nbChamps++) {
+        if (!geant_verifieRegles())
+            return 1;
+    }
+    for (int d = 0; d < 5; d++) {
+        for (int t = 0; t < 5; t++) {
+            for (int essai = 0; essai < 4; essai++, nbChamps++) {
+                if (!geant_verifieDevoilement(61 + essai, 37 + 8 * essai, densites[d], tuiles[t]))
+                    return 1;
+            }
+        }
+    }
+    printf("geant: %d champs identiques\n", nbChamps);
+    return 0;
+}
+
+/*
+ * @brief Place des mines au hasard sur un champ gant de NB_LIGNE x NB_COL
+ * cases, le charge dans m_tabMines avec masque_decompacte() (mme format
+ * que 'L') et compare les chiffres de metToucheCombien()  ceux du mode gant.
+ * @param rien
+ * @return vrai si les cases sont identiques
+ */
+static bool geant_verifieRegles(void)
+{
+    Champ c;
+    unsigned char masque[NB_OCTETS_MASQUE];
+    uint64_t nbMines = geant_alea() % 41;
+    bool identique = true;
+
+    if (!geant_ouvre(&c, NB_LIGNE, NB_COL, 1 + geant_alea() % NB_LIGNE))
+        return false;
+    geant_place(&c, nbMines);
+    if (pread(c.mines.fd, masque, sizeof masque, 0) != sizeof masque
+        || masque_decompacte(masque) != nbMines) {
+        puts("geant: placement different du masque");
+        geant_ferme(&c);
+        return false;
+    }
+    metToucheCombien();
+    geant_projette(&c, &c.mines, 0, NB_LIGNE);
+    for (uint8_t i = 0; i < NB_LIGNE; i++) {
+        for (uint8_t j = 0; j < NB_COL; j++) {
+            if (geant_case(&c, i, j) != m_tabMines[i][j]) {
+                printf("geant: case (%d, %d) differente de metToucheCombien()\n", i, j);
+                identique = false;
+            }
+        }
+    }
+    geant_ferme(&c);
+    return identique;
+}
+
+/*
+ * @brief Dvoile un champ gant et compare la vue  un remplissage en
+ * mmoire du mme champ, avec une pile de toutes les cases.
+ * @param nbLignes, nbCol Taille du champ
+ * @param densite Pourcentage de mines
+ * @param lignesParTuile Hauteur des tuiles
+ * @return vrai si les vues sont identiques
+ */
+static bool geant_verifieDevoilement(uint64_t nbLignes, uint64_t nbCol, int densite, uint64_t lignesParTuile)
+{
+    Champ c;
+    uint64_t nbCases = nbLignes * nbCol;
+    uint64_t histogramme[9], depart, nbPassages, nbDevoilees, attendues = 1;
+    char* tab; //valeur de chaque case, VIDE tant qu'une case vide est couverte
+    uint64_t* pile;
+    uint64_t nbPile = 0, k;
+    bool identique = true;
+
+    if (!geant_ouvre(&c, nbLignes, nbCol, lignesParTuile))
+        return false;
+    tab = malloc(nbCases);
+    pile = malloc(nbCases * sizeof(uint64_t));
+    geant_place(&c, nbCases * densite / 100);
+    if (geant_chiffres(&c, histogramme, &depart)) {
+        geant_projette(&c, &c.mines, 0, nbLignes);
+        for (k = 0; k < nbCases; k++) {
+            tab[k] = geant_case(&c, k / nbCol, k % nbCol);
+            if (tab[k] == ' ')
+                tab[k] = VIDE;
+        }
+        tab[depart] = ' ';
+        pile[nbPile++] = depart;
+        while (nbPile > 0) {
+            k = pile[--nbPile];
+            for (int64_t i = (int64_t) (k / nbCol) - 1; i <= (int64_t) (k / nbCol) + 1; i++) {
+                for (int64_t j = (int64_t) (k % nbCol) - 1; j <= (int64_t) (k % nbCol) + 1; j++) {
+                    if (i < 0 || i >= (int64_t) nbLignes || j < 0 || j >= (int64_t) nbCol)
+                        continue;
+                    if (tab[i * nbCol + j] == VIDE) {
+                        tab[i * nbCol + j] = ' ';
+                        pile[nbPile++] = i * nbCol + j;
+                        attendues++;
+                    } else if (tab[i * nbCol + j] >= '1' && tab[i * nbCol + j] <= '8') {
+                        tab[i * nbCol + j] |= 0x80; //chiffre dvoil
+                        attendues++;
+                    }
+                }
+            }
+        }
+        nbDevoilees = geant_devoile(&c, depart, &nbPassages);
+        geant_projette(&c, &c.vue, 0, nbLignes);
+        for (k = 0; k < nbCases; k++) {
+            if (geant_bit(&c.vue, k) != (tab[k] == ' ' || (tab[k] & 0x80)))
+                identique = false;
+        }
+        if (!identique || nbDevoilees != attendues)
+            printf("geant: devoilement different, %llux%llu, %d %%, tuiles de %llu lignes\n",
+                   (unsigned long long) nbLignes, (unsigned long long) nbCol, densite,
+                   (unsigned long long) lignesParTuile);
+        identique = identique && nbDevoilees == attendues;
+    }
+    geant_ferme(&c);
+    free(tab);
+    free(pile);
+    return identique;
+}
+
+/*
+ * @brief Gnrateur xorshift64*: rand() est trop court pour 10^9 cases.
+ * @param rien
+ * @return 64 bits au hasard
+ */
+static uint64_t geant_alea(void)
+{
+    m_alea ^= m_alea >> 12;
+    m_alea ^= m_alea << 25;
+    m_alea ^= m_alea >> 27;
+    return m_alea * 2685821657736338717ULL;
+}
+
+/*
+ * @brief Lit l'horloge monotone.
+ * @param rien
+ * @return le temps en secondes
+ */
+static double geant_maintenant(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
@@ -0,0 +1,360 @@
+/**
+ * @file   generation.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Rserve de champs sans devinette gnre sur l'ordinateur, 
+ * charger sur le PIC avec la commande 'L'.
+ *
+ * Usage: generation [-n champs] [-m mines] [-f fils] [-o fichier] [-v]
+ *  -n  champs accepts par densit (1000 par dfaut)
+ *  -m  une seule densit (par dfaut: MINES_MIN  MINES_MAX par MINES_PAS)
+ *  -f  fils d'excution (par dfaut: un par coeur, au moins 2)
+ *  -o  crit les champs accepts en trames 'L' (commande.h): 'L', masque,
+ *      CRC-8. Une trame se charge avec, par exemple,
+ *      dd if=champs.L bs=12 skip=k count=1 > /dev/ttyUSB0
+ *  -v  relit le fichier et vrifie chaque trame comme le PIC la chargerait
+ *
+ * La gnration est un pipeline:
+ *  - les fils gnrateurs tirent des champs candidats (masques compacts) et
+ *    les ajoutent  une file sans verrou (file.h);
+ *  - les fils validateurs les retirent et les font rsoudre par le solveur
+ *    du PIC depuis la premire case vide (solveur_verifie(), solveur.c), la
+ *    case que la commande 'L' dvoile. Un champ qui bloque est rpar; les
+ *    champs accepts passent par une deuxime file;
+ *  - le fil principal les compte et les crit, puis arrte les autres quand
+ *    la rserve est pleine.
+ * Chaque fil a son propre tat du jeu (LOCAL_FIL, demineur.h). La
+ * validation cote beaucoup plus cher que le tirage: un gnrateur pour
+ * PAR_GENERATEUR fils, les autres valident.
+ *
+ * Une ligne JSON par nombre de mines:
+ *  {"taille":"4x20","mines":..,"champs":..,"candidats":..,"premier":..,
+ *   "validations":..,"generateurs":..,"validateurs":..,"champs_par_s":..}
+ * o candidats est le nombre de champs passs au solveur, premier le nombre
+ * de candidats accepts sans rparation et validations le nombre moyen de
+ * passages du solveur par candidat. Les validateurs finissent le candidat en
+ * cours aprs l'arrt: candidats et premier comptent aussi ces champs, qui
+ * ne sont pas dans la rserve. Le temps sur le PIC se mesure avec la
+ * commande 'G' (voir mesure.h).
+ */
+
+#define _POSIX_C_SOURCE 200809L //clock_gettime(), getopt(), sysconf()
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include "../demineur.h"
+#include "../masque.h"
+#include "../hasard.h"
+#include "../solveur.h"
+#include "file.h"
+
+#define MINES_MIN 6
+#define MINES_MAX 24
+#define MINES_PAS 3
+#define CHAMPS_DEFAUT 1000
+#define PAR_GENERATEUR 8 //fils par fil gnrateur
+#define FILS_MAX 256
+#define TAILLE_FILE 1024 //places de chaque file
+#define TRAME_CHARGE 'L' //commande de chargement (commande.h)
+#define TAILLE_TRAME (NB_OCTETS_MASQUE + 2) //'L', masque, CRC-8
+
+/*
+ * Champ qui passe d'un fil  l'autre dans les files.
+ */
+typedef struct {
+    unsigned char masque[NB_OCTETS_MASQUE];
+    uint8_t nbMines;
+} Champ;
+
+/*
+ * Pipeline d'une densit, partag par tous les fils.
+ */
+typedef struct {
+    File* candidats; //gnrateurs -> validateurs
+    File* acceptes; //validateurs -> fil principal
+    uint8_t nbMines;
+    atomic_bool arret; //mis par le fil principal quand la rserve est pleine
+} Pipeline;
+
+/*
+ * Un fil du pipeline et ses compteurs, lus par le fil principal aprs
+ * pthread_join().
+ */
+typedef struct {
+    Pipeline* pipeline;
+    pthread_t fil;
+    uint64_t alea; //tat xorshift64* du gnrateur
+    unsigned int germe; //germe de hasard() du validateur (rparations)
+    long nbCandidats, nbPremiers, nbValidations;
+} Fil;
+
+static void* generation_genere(void* arg);
+static void* generation_valide(void* arg);
+static void generation_tire(Fil* fil, Champ* champ);
+static void generation_ecrit(FILE* sortie, const Champ* champ);
+static long generation_verifie(const char* nomFichier);
+static double generation_maintenant(void);
+
+int main(int argc, char** argv)
+{
+    long nbChamps = CHAMPS_DEFAUT;
+    int minesMin = MINES_MIN, minesMax = MINES_MAX;
+    long nbFils = sysconf(_SC_NPROCESSORS_ONLN);
+    const char* nomFichier = NULL;
+    bool verification = false;
+    FILE* sortie = NULL;
+    static Fil fils[FILS_MAX];
+    int nbGenerateurs, opt;
+
+    while ((opt = getopt(argc, argv, "n:m:f:o:v")) != -1) {
+        switch (opt) {
+            case 'n':
+                nbChamps = atol(optarg);
+                break;
+            case 'm':
+                minesMin = minesMax = atoi(optarg);
+                break;
+            case 'f':
+                nbFils = atol(optarg);
+                break;
+            case 'o':
+                nomFichier = optarg;
+                break;
+            case 'v':
+                verification = true;
+                break;
+            default:
+                fprintf(stderr, "usage: generation [-n champs] [-m mines] [-f fils] [-o fichier] [-v]\n");
+                return 2;
+        }
+    }
+    if (nbChamps < 1)
+        nbChamps = CHAMPS_DEFAUT;
+    if (minesMin < 1 || minesMax > NB_CASES - 9) { //il faut au moins une case vide et son 3x3
+        fprintf(stderr, "generation: de 1 a %d mines\n", NB_CASES - 9);
+        return 2;
+    }
+    if (nbFils < 2)
+        nbFils = 2;
+    if (nbFils > FILS_MAX)
+        nbFils = FILS_MAX;
+    nbGenerateurs = (nbFils + PAR_GENERATEUR - 1) / PAR_GENERATEUR;
+    if (nomFichier != NULL && (sortie = fopen(nomFichier, "wb")) == NULL) {
+        perror(nomFichier);
+        return 1;
+    }
+
+    for (int nbMines = minesMin; nbMines <= minesMax; nbMines += MINES_PAS) {
+        Pipeline pipeline = {file_cree(TAILLE_FILE, sizeof(Champ)), file_cree(TAILLE_FILE, sizeof(Champ)),
+                             nbMines};
+        long nbCandidats = 0, nbPremiers = 0, nbValidations = 0;
+        Champ champ;
+        double debut;
+
+        if (pipeline.candidats == NULL || pipeline.acceptes == NULL) {
+            fprintf(stderr, "generation: memoire insuffisante\n");
+            return 1;
+        }
+        atomic_init(&pipeline.arret, false);
+        debut = generation_maintenant();
+        for (int i = 0; i < nbFils; i++) {
+            fils[i] = (Fil) {&pipeline};
+            fils[i].alea = 0x9E3779B97F4A7C15ULL * (uint64_t) (nbMines * FILS_MAX + i + 1);
+            fils[i].germe = nbMines * FILS_MAX + i + 1;
+            pthread_create(&fils[i].fil, NULL, i < nbGenerateurs ? generation_genere : generation_valide,
+                           &fils[i]);
+        }
+        for (long k = 0; k < nbChamps;) {
+            if (file_retire(pipeline.acceptes, &champ)) {
+                if (sortie != NULL)
+                    generation_ecrit(sortie, &champ);
+                k++;
+            } else
+                sched_yield();
+        }
+        atomic_store(&pipeline.arret, true);
+        for (int i = 0; i < nbFils; i++) {
+            pthread_join(fils[i].fil, NULL);
+            nbCandidats += fils[i].nbCandidats;
+            nbPremiers += fils[i].nbPremiers;
+            nbValidations += fils[i].nbValidations;
+        }
+        printf("{\"taille\":\"%dx%d\",\"mines\":%d,\"champs\":%ld,\"candidats\":%ld,\"premier\":%ld,"
+               "\"validations\":%.2f,\"generateurs\":%d,\"validateurs\":%ld,\"champs_par_s\":%.0f}\n",
+               NB_LIGNE, NB_COL, nbMines, nbChamps, nbCandidats, nbPremiers,
+               (double) nbValidations / nbCandidats, nbGenerateurs, nbFils - nbGenerateurs,
+               nbChamps / (generation_maintenant() - debut));
+        file_detruit(pipeline.candidats);
+        file_detruit(pipeline.acceptes);
+    }
+
+    if (sortie != NULL && fclose(sortie) != 0) {
+        perror(nomFichier);
+        return 1;
+    }
+    if (verification && nomFichier != NULL) {
+        long nbValides = generation_verifie(nomFichier);
+
+        if (nbValides < 0)
+            return 1;
+        printf("generation: %ld trames valides dans %s\n", nbValides, nomFichier);
+    }
+    return 0;
+}
+
+/*
+ * @brief Fil gnrateur: tire des candidats jusqu' l'arrt du pipeline.
+ * @param void* arg Le Fil
+ * @return NULL
+ */
+static void* generation_genere(void* arg)
+{
+    Fil* fil = arg;
+    Champ champ;
+
+    while (!atomic_load_explicit(&fil->pipeline->arret, memory_order_relaxed)) {
+        generation_tire(fil, &champ);
+        while (!file_ajoute(fil->pipeline->candidats, &champ)) { //les validateurs sont en retard
+            if (atomic_load_explicit(&fil->pipeline->arret, memory_order_relaxed))
+                return NULL;
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/*
+ * @brief Fil validateur: passe chaque candidat au solveur et transmet les
+ * champs accepts (rpars au besoin) au fil principal.
+ * @param void* arg Le Fil
+ * @return NULL
+ */
+static void* generation_valide(void* arg)
+{
+    Fil* fil = arg;
+    Champ champ;
+
+    hasard_germe(fil->germe); //les rparations choisissent leurs cases avec hasard()
+    while (!atomic_load_explicit(&fil->pipeline->arret, memory_order_relaxed)) {
+        if (!file_retire(fil->pipeline->candidats, &champ)) {
+            sched_yield();
+            continue;
+        }
+        masque_decompacte(champ.masque);
+        metToucheCombien();
+        fil->nbCandidats++;
+        if (solveur_verifie(champ.nbMines)) {
+            if (m_nbValidations == 1)
+                fil->nbPremiers++;
+            masque_compacte(champ.masque, m_tabMines, MINE);
+            while (!file_ajoute(fil->pipeline->acceptes, &champ)) {
+                if (atomic_load_explicit(&fil->pipeline->arret, memory_order_relaxed))
+                    break;
+                sched_yield();
+            }
+        }
+        fil->nbValidations += m_nbValidations;
+    }
+    return NULL;
+}
+
+/*
+ * @brief Tire un champ candidat: nbMines cases distinctes, par un mlange de
+ * Fisher-Yates partiel. hasard() n'a que 65535 tats, donc autant de champs
+ * diffrents au plus: les gnrateurs utilisent un xorshift64*.
+ * @param Fil* fil Le gnrateur (son tat xorshift64*)
+ * @param Champ* champ Reoit le masque
+ * @return rien
+ */
+static void generation_tire(Fil* fil, Champ* champ)
+{
+    uint16_t cases[NB_CASES];
+    uint16_t echange;
+    unsigned int k;
+
+    for (k = 0; k < NB_CASES; k++)
+        cases[k] = k;
+    for (k = 0; k < NB_OCTETS_MASQUE; k++)
+        champ->masque[k] = 0;
+    for (k = 0; k < fil->pipeline->nbMines; k++) {
+        unsigned int choix;
+
+        fil->alea ^= fil->alea >> 12;
+        fil->alea ^= fil->alea << 25;
+        fil->alea ^= fil->alea >> 27;
+        choix = k + (fil->alea * 2685821657736338717ULL >> 32) % (NB_CASES - k);
+        echange = cases[k];
+        cases[k] = cases[choix];
+        cases[choix] = echange;
+        MASQUE_MET(champ->masque, cases[k]);
+    }
+    champ->nbMines = fil->pipeline->nbMines;
+}
+
+/*
+ * @brief crit un champ en trame 'L' (commande.h).
+ * @param FILE* sortie Le fichier
+ * @param const Champ* champ Le champ
+ * @return rien
+ */
+static void generation_ecrit(FILE* sortie, const Champ* champ)
+{
+    putc(TRAME_CHARGE, sortie);
+    fwrite(champ->masque, 1, NB_OCTETS_MASQUE, sortie);
+    putc(masque_crc8(champ->masque, NB_OCTETS_MASQUE), sortie);
+}
+
+/*
+ * @brief Relit un fichier de trames et refait ce que fait le PIC pour
+ * chacune: vrifie le CRC-8, charge le champ, calcule les chiffres, puis
+ * vrifie qu'il se rsout sans deviner depuis sa premire case vide, sans
+ * rparation.
+ * @param const char* nomFichier Le fichier crit avec -o
+ * @return le nombre de trames, -1 si une trame est invalide
+ */
+static long generation_verifie(const char* nomFichier)
+{
+    FILE* entree = fopen(nomFichier, "rb");
+    unsigned char trame[TAILLE_TRAME];
+    long nb = 0;
+    uint8_t nbMines;
+
+    if (entree == NULL) {
+        perror(nomFichier);
+        return -1;
+    }
+    while (fread(trame, 1, TAILLE_TRAME, entree) == TAILLE_TRAME) {
+        if (trame[0] != TRAME_CHARGE || trame[TAILLE_TRAME - 1] != masque_crc8(trame + 1, NB_OCTETS_MASQUE)) {
+            printf("generation: trame %ld mal formee\n", nb);
+            fclose(entree);
+            return -1;
+        }
+        nbMines = masque_decompacte(trame + 1);
+        metToucheCombien();
+        if (!solveur_verifie(nbMines) || m_nbValidations != 1) {
+            printf("generation: le champ %ld demande de deviner\n", nb);
+            fclose(entree);
+            return -1;
+        }
+        nb++;
+    }
+    fclose(entree);
+    return nb;
+}
+
+/*
+ * @brief Lit l'horloge monotone.
+ * @param rien
+ * @return le temps en secondes
+ */
+static double generation_maintenant(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
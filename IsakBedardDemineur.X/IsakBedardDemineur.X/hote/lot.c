@@ -0,0 +1,561 @@
+/**
+ * @file   lot.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Lots de parties rangs par case. Voir lot.h.
+ *
+ * La case c du champ k est  l'indice c * pas + k de vue et de mines. pas
+ * est nbChamps arrondi  un multiple impair de la ligne de cache: avec un
+ * pas multiple de 4096, les cases d'un champ tomberaient toutes dans le mme
+ * ensemble du cache.
+ * Un coup se fait en quatre passes sur des blocs de champs du fil:
+ *  1. la case joue de chaque champ: mine (perdu), case vide ( ouvrir),
+ *     chiffre  dvoiler, ou chiffre dvoil (accord): les drapeaux et les
+ *     tuiles de son 3x3 sont compts comme dans devoileAutour(). Un accord
+ *     sans mine et sans case vide dvoile le mme 3x3 qu'une case vide; un
+ *     accord qui ouvre une zone vide est jou par regles.c (demine());
+ *  2. le 3x3 des cases vides joues: chaque case de chaque champ est
+ *     dvoile si elle est voisine de la case joue, une tuile et sans mine
+ *     (enleveTuilesAutour()), par une slection sans branche;
+ *  3. les tuiles et drapeaux de chaque champ sont compts (gagne()). Le
+ *     compte est sur 8 bits, comme dans gagne();
+ *  4. rsultat de chaque champ, nouvelle partie pour les champs termins
+ *     (lot_refait()).
+ * Les passes 2 et 3 parcourent les cases dans l'ordre de la mmoire et les
+ * champs dans la boucle intrieure: une instruction vectorielle traite 16
+ * ou 32 champs.
+ */
+
+#define _POSIX_C_SOURCE 200809L //pthread_barrier_t
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "../demineur.h"
+#include "../hasard.h"
+#include "lot.h"
+
+#define ALIGNEMENT 64 //tranches alignes sur les lignes de cache
+#define TAILLE_BLOC 256 //champs traits ensemble: leurs cases restent dans le cache entre les passes
+
+/*
+ * Paramtre d'un fil du lot.
+ */
+typedef struct {
+    Lot* lot;
+    unsigned int noFil;
+} Tranche;
+
+enum {
+    ACCORD_RIEN, //pas autant de drapeaux que le chiffre
+    ACCORD_PERDU, //un drapeau est mal plac
+    ACCORD_OUVRE, //le 3x3 se dvoile comme autour d'une case vide
+    ACCORD_REGLES //une case vide est dvoile: sa zone s'ouvre par regles.c
+};
+
+typedef enum {
+    TRAVAIL_REINITIALISE,
+    TRAVAIL_DEVOILE,
+    TRAVAIL_DRAPEAU,
+    TRAVAIL_ARRET
+} Operation;
+
+struct Lot {
+    unsigned int nbChamps;
+    size_t pas; //distance entre deux cases d'un mme champ
+    unsigned char* vue; //m_tabVue de chaque champ, par case
+    unsigned char* mines; //m_tabMines de chaque champ, par case
+    uint8_t* nbMines; //m_partie.nbMines de chaque champ
+    unsigned int* hasard; //tat de hasard() de chaque champ
+    uint8_t* ouvre; //1 si le coup est sur une case vide (passe 2)
+    uint8_t* perdu; //1 si le coup a touch une mine
+    uint8_t* voisin; //1 si la ligne en cours est voisine de la case vide joue (passe 2)
+    uint8_t* compte; //tuiles et drapeaux (passe 3)
+    uint8_t* colonnes; //mines de chaque colonne sur trois lignes (lot_refait()), par colonne
+    uint8_t* refait; //1 si le champ commence une nouvelle partie
+    unsigned int nbFils;
+    pthread_t* fils;
+    Tranche* tranches;
+    pthread_barrier_t debut, fin; //dbut et fin d'un travail pour tous les fils
+    Operation operation; //travail en cours et ses paramtres
+    const unsigned int* germes;
+    const uint8_t* mines0;
+    const uint8_t* x;
+    const uint8_t* y;
+    char* resultats;
+    unsigned char* vues;
+};
+
+static void* lot_fil(void* arg);
+static void lot_travaille(Lot* lot, Operation operation);
+static void lot_tranche(Lot* lot, unsigned int noFil);
+static void lot_devoileTranche(Lot* lot, unsigned int debut, unsigned int fin);
+static void lot_drapeauTranche(Lot* lot, unsigned int debut, unsigned int fin);
+static void lot_vuesTranche(Lot* lot, unsigned int debut, unsigned int fin);
+static char lot_accord(const Lot* lot, unsigned int k);
+static void lot_refait(Lot* lot, unsigned int debut, unsigned int fin);
+static void lot_sort(const Lot* lot, unsigned int k);
+static void lot_rangeVue(Lot* lot, unsigned int k);
+
+/*
+ * @brief Alloue un lot et lance ses fils. Voir lot.h.
+ * @param unsigned int nbChamps, unsigned int nbFils Voir lot.h
+ * @return le lot, NULL si la mmoire manque
+ */
+Lot* lot_cree(unsigned int nbChamps, unsigned int nbFils)
+{
+    Lot* lot = calloc(1, sizeof *lot);
+
+    if (lot == NULL)
+        return NULL;
+    if (nbFils < 1)
+        nbFils = 1;
+    lot->nbChamps = nbChamps;
+    lot->nbFils = nbFils;
+    lot->pas = (nbChamps + ALIGNEMENT - 1) / ALIGNEMENT * ALIGNEMENT;
+    if (lot->pas / ALIGNEMENT % 2 == 0)
+        lot->pas += ALIGNEMENT;
+    lot->vue = malloc(NB_CASES * lot->pas);
+    lot->mines = malloc(NB_CASES * lot->pas);
+    lot->nbMines = malloc(nbChamps);
+    lot->hasard = malloc(nbChamps * sizeof *lot->hasard);
+    lot->ouvre = malloc(nbChamps);
+    lot->perdu = malloc(nbChamps);
+    lot->voisin = malloc(nbChamps);
+    lot->compte = malloc(nbChamps);
+    lot->refait = malloc(nbChamps);
+    lot->colonnes = malloc(NB_COL * lot->pas);
+    lot->fils = malloc(nbFils * sizeof *lot->fils);
+    lot->tranches = malloc(nbFils * sizeof *lot->tranches);
+    if (lot->vue == NULL || lot->mines == NULL || lot->nbMines == NULL || lot->hasard == NULL
+            || lot->ouvre == NULL || lot->perdu == NULL || lot->voisin == NULL || lot->compte == NULL || lot->refait == NULL
+            || lot->colonnes == NULL
+            || lot->fils == NULL
+            || lot->tranches == NULL) {
+        lot->nbFils = 1; //aucun fil lanc
+        lot_detruit(lot);
+        return NULL;
+    }
+    if (nbFils > 1) {
+        pthread_barrier_init(&lot->debut, NULL, nbFils);
+        pthread_barrier_init(&lot->fin, NULL, nbFils);
+        for (unsigned int f = 1; f < nbFils; f++) { //le fil appelant fait la tranche 0
+            lot->tranches[f].lot = lot;
+            lot->tranches[f].noFil = f;
+            pthread_create(&lot->fils[f], NULL, lot_fil, &lot->tranches[f]);
+        }
+    }
+    return lot;
+}
+
+/*
+ * @brief Arrte les fils et libre le lot. Voir lot.h.
+ * @param Lot* lot Le lot
+ * @return rien
+ */
+void lot_detruit(Lot* lot)
+{
+    if (lot->fils != NULL && lot->nbFils > 1) {
+        lot_travaille(lot, TRAVAIL_ARRET);
+        for (unsigned int f = 1; f < lot->nbFils; f++)
+            pthread_join(lot->fils[f], NULL);
+        pthread_barrier_destroy(&lot->debut);
+        pthread_barrier_destroy(&lot->fin);
+    }
+    free(lot->vue);
+    free(lot->mines);
+    free(lot->nbMines);
+    free(lot->hasard);
+    free(lot->ouvre);
+    free(lot->perdu);
+    free(lot->voisin);
+    free(lot->compte);
+    free(lot->refait);
+    free(lot->colonnes);
+    free(lot->fils);
+    free(lot->tranches);
+    free(lot);
+}
+
+/*
+ * @brief Nouvelle partie sur chaque champ. Voir lot.h.
+ */
+void lot_reinitialise(Lot* lot, const unsigned int* germes, const uint8_t* nbMines, unsigned char* vues)
+{
+    lot->germes = germes;
+    lot->mines0 = nbMines;
+    lot->vues = vues;
+    lot_travaille(lot, TRAVAIL_REINITIALISE);
+}
+
+/*
+ * @brief Dvoile une case par champ. Voir lot.h.
+ */
+void lot_devoile(Lot* lot, const uint8_t* x, const uint8_t* y, char* resultats, unsigned char* vues)
+{
+    lot->x = x;
+    lot->y = y;
+    lot->resultats = resultats;
+    lot->vues = vues;
+    lot_travaille(lot, TRAVAIL_DEVOILE);
+}
+
+/*
+ * @brief Drapeau sur une case par champ. Voir lot.h.
+ */
+void lot_drapeau(Lot* lot, const uint8_t* x, const uint8_t* y, unsigned char* vues)
+{
+    lot->x = x;
+    lot->y = y;
+    lot->vues = vues;
+    lot_travaille(lot, TRAVAIL_DRAPEAU);
+}
+
+/*
+ * @brief Boucle d'un fil du lot: attend un travail, fait sa tranche.
+ * @param void* arg La Tranche du fil
+ * @return NULL
+ */
+static void* lot_fil(void* arg)
+{
+    Tranche* tranche = arg;
+    Lot* lot = tranche->lot;
+
+    for (;;) {
+        pthread_barrier_wait(&lot->debut);
+        if (lot->operation == TRAVAIL_ARRET)
+            return NULL;
+        lot_tranche(lot, tranche->noFil);
+        pthread_barrier_wait(&lot->fin);
+    }
+}
+
+/*
+ * @brief Fait faire un travail par tous les fils et attend la fin. Les
+ * paramtres sont dj dans le lot; la barrire les publie.
+ * @param Lot* lot Le lot
+ * @param Operation operation Le travail
+ * @return rien
+ */
+static void lot_travaille(Lot* lot, Operation operation)
+{
+    lot->operation = operation;
+    if (lot->nbFils == 1) {
+        lot_tranche(lot, 0);
+        return;
+    }
+    pthread_barrier_wait(&lot->debut);
+    if (operation == TRAVAIL_ARRET)
+        return;
+    lot_tranche(lot, 0);
+    pthread_barrier_wait(&lot->fin);
+}
+
+/*
+ * @brief Fait le travail en cours sur la tranche d'un fil. Les tranches
+ * ont un multiple de ALIGNEMENT champs: dans les tableaux par case, deux
+ * fils ne se partagent presque jamais une ligne de cache.
+ * @param Lot* lot Le lot
+ * @param unsigned int noFil Le numro du fil
+ * @return rien
+ */
+static void lot_tranche(Lot* lot, unsigned int noFil)
+{
+    unsigned int parFil = (lot->nbChamps + lot->nbFils - 1) / lot->nbFils;
+    unsigned int debut, fin;
+
+    parFil = (parFil + ALIGNEMENT - 1) / ALIGNEMENT * ALIGNEMENT;
+    debut = noFil * parFil;
+    fin = debut + parFil;
+    if (fin > lot->nbChamps)
+        fin = lot->nbChamps;
+    for (unsigned int bloc = debut; bloc < fin; bloc += TAILLE_BLOC) {
+        unsigned int finBloc = bloc + TAILLE_BLOC < fin ? bloc + TAILLE_BLOC : fin;
+
+        switch (lot->operation) {
+            case TRAVAIL_REINITIALISE:
+                for (unsigned int k = bloc; k < finBloc; k++) {
+                    lot->hasard[k] = lot->germes[k];
+                    lot->nbMines[k] = lot->mines0[k];
+                    lot->refait[k] = 1;
+                }
+                lot_refait(lot, bloc, finBloc);
+                break;
+            case TRAVAIL_DEVOILE:
+                lot_devoileTranche(lot, bloc, finBloc);
+                break;
+            case TRAVAIL_DRAPEAU:
+                lot_drapeauTranche(lot, bloc, finBloc);
+                break;
+            case TRAVAIL_ARRET:
+                return;
+        }
+        if (lot->vues != NULL)
+            lot_vuesTranche(lot, bloc, finBloc); //les cases du bloc sont encore dans le cache
+    }
+}
+
+/*
+ * @brief Dvoile la case de chaque champ de la tranche, en quatre passes
+ * (voir l'entte).
+ * @param Lot* lot Le lot
+ * @param unsigned int debut, fin Les champs de la tranche
+ * @return rien
+ */
+static void lot_devoileTranche(Lot* lot, unsigned int debut, unsigned int fin)
+{
+    size_t n = lot->pas;
+    const uint8_t* restrict x = lot->x;
+    const uint8_t* restrict y = lot->y;
+    uint8_t* restrict ouvre = lot->ouvre;
+    uint8_t* restrict perdu = lot->perdu;
+    uint8_t* restrict compte = lot->compte;
+    uint8_t* restrict voisin = lot->voisin;
+    unsigned char m, v;
+    size_t c;
+
+    for (unsigned int k = debut; k < fin; k++) { //passe 1: la case joue
+        c = (size_t) ((y[k] - 1) * NB_COL + x[k] - 1) * n + k;
+        m = lot->mines[c];
+        v = lot->vue[c];
+        ouvre[k] = m == ' ';
+        perdu[k] = m == MINE;
+        if (m == MINE || m == ' ')
+            continue;
+        if (v != m) {
+            if (v != DRAPEAU)
+                lot->vue[c] = m;
+            continue;
+        }
+        switch (lot_accord(lot, k)) {
+            case ACCORD_OUVRE:
+                ouvre[k] = 1; //passe 2
+                break;
+            case ACCORD_PERDU:
+                perdu[k] = 1;
+                break;
+            case ACCORD_REGLES: //zone vide  ouvrir: rare
+                lot_sort(lot, k);
+                demine(x[k], y[k]);
+                lot_rangeVue(lot, k);
+                break;
+        }
+    }
+
+    for (unsigned int i = 0; i < NB_LIGNE; i++) { //passe 2: 3x3 des cases vides joues
+        uint8_t ligne = i + 2; //i + 1 - y dans [-1, 1], sur 8 bits
+
+        for (unsigned int k = debut; k < fin; k++)
+            voisin[k] = ouvre[k] & ((uint8_t) (ligne - y[k]) <= 2);
+        for (unsigned int j = 0; j < NB_COL; j++) {
+            unsigned char* restrict vue = lot->vue + (i * NB_COL + j) * n;
+            const unsigned char* restrict mines = lot->mines + (i * NB_COL + j) * n;
+            uint8_t colonne = j + 2;
+
+            for (unsigned int k = debut; k < fin; k++) {
+                uint8_t devoile = -(uint8_t) (voisin[k] & ((uint8_t) (colonne - x[k]) <= 2)
+                        & (vue[k] == TUILE) & (mines[k] != MINE)); //0xFF ou 0
+
+                vue[k] = (vue[k] & ~devoile) | (mines[k] & devoile);
+            }
+        }
+    }
+
+    for (unsigned int k = debut; k < fin; k++) //passe 3: tuiles et drapeaux
+        compte[k] = 0;
+    for (c = 0; c < NB_CASES; c++) {
+        const unsigned char* restrict vue = lot->vue + c * n;
+
+        for (unsigned int k = debut; k < fin; k++)
+            compte[k] += (vue[k] == TUILE) | (vue[k] == DRAPEAU);
+    }
+
+    for (unsigned int k = debut; k < fin; k++) { //passe 4: rsultats
+        lot->refait[k] = 1;
+        if (perdu[k])
+            lot->resultats[k] = PARTIE_PERDUE;
+        else if (compte[k] == lot->nbMines[k]) {
+            lot->nbMines[k]++; //comme gagne()
+            lot->resultats[k] = PARTIE_GAGNEE;
+        } else {
+            lot->resultats[k] = PARTIE_EN_COURS;
+            lot->refait[k] = 0;
+        }
+    }
+    lot_refait(lot, debut, fin);
+}
+
+/*
+ * @brief Met ou enlve le drapeau de chaque champ de la tranche, comme
+ * metOuEnleveDrapeau(): une seule case par champ, rien  vectoriser.
+ * @param Lot* lot Le lot
+ * @param unsigned int debut, fin Les champs de la tranche
+ * @return rien
+ */
+static void lot_drapeauTranche(Lot* lot, unsigned int debut, unsigned int fin)
+{
+    size_t n = lot->pas;
+    unsigned char* vue;
+
+    for (unsigned int k = debut; k < fin; k++) {
+        vue = lot->vue + (size_t) ((lot->y[k] - 1) * NB_COL + lot->x[k] - 1) * n + k;
+        if (*vue == TUILE)
+            *vue = DRAPEAU;
+        else if (*vue == DRAPEAU)
+            *vue = TUILE;
+    }
+}
+
+/*
+ * @brief Copie les vues des champs d'un bloc, par case comme dans le lot:
+ * une copie contigu par case.
+ * @param Lot* lot Le lot
+ * @param unsigned int debut, fin Les champs du bloc
+ * @return rien
+ */
+static void lot_vuesTranche(Lot* lot, unsigned int debut, unsigned int fin)
+{
+    for (size_t c = 0; c < NB_CASES; c++)
+        memcpy(lot->vues + c * lot->nbChamps + debut, lot->vue + c * lot->pas + debut, fin - debut);
+}
+
+/*
+ * @brief Classe un accord sur le chiffre jou d'un champ, comme
+ * devoileAutour(): drapeaux du 3x3 compts, puis mines et cases vides sous
+ * ses tuiles. Les mines touches ne sont pas notes MINE_EXPLOSEE: la
+ * partie perdue est aussitt remplace.
+ * @param const Lot* lot Le lot
+ * @param unsigned int k Le champ, dont lot->x et lot->y sont un chiffre
+ * dvoil
+ * @return ACCORD_RIEN, ACCORD_PERDU, ACCORD_OUVRE ou ACCORD_REGLES
+ */
+static char lot_accord(const Lot* lot, unsigned int k)
+{
+    unsigned int x = lot->x[k] - 1, y = lot->y[k] - 1;
+    unsigned int ligneMax = VOISIN_MAX(y, NB_LIGNE), colonneMax = VOISIN_MAX(x, NB_COL);
+    unsigned char nbDrapeaux = 0, v, m;
+    bool touche = false, vide = false;
+    size_t c;
+
+    for (unsigned int j = VOISIN_MIN(y); j <= ligneMax; j++)
+        for (unsigned int i = VOISIN_MIN(x); i <= colonneMax; i++) {
+            c = (j * NB_COL + i) * lot->pas + k;
+            v = lot->vue[c];
+            m = lot->mines[c];
+            nbDrapeaux += v == DRAPEAU;
+            touche |= v == TUILE && m == MINE;
+            vide |= v == TUILE && m == ' ';
+        }
+    if (nbDrapeaux != lot->mines[(y * NB_COL + x) * lot->pas + k] - '0')
+        return ACCORD_RIEN;
+    if (touche)
+        return ACCORD_PERDU;
+    return vide ? ACCORD_REGLES : ACCORD_OUVRE;
+}
+
+/*
+ * @brief Nouvelle partie sur les champs d'un bloc dont refait vaut 1, comme
+ * preparePartie() hors mode sans devinette: champ vid et tuiles (passe sans
+ * branche), mines tires par la suite de hasard() de chaque champ dans le
+ * mme ordre que rempliMines(), puis chiffres compts comme
+ * metToucheCombien(), case par case sur tous les champs du bloc.
+ * @param Lot* lot Le lot
+ * @param unsigned int debut, fin Les champs du bloc
+ * @return rien
+ */
+static void lot_refait(Lot* lot, unsigned int debut, unsigned int fin)
+{
+    size_t n = lot->pas;
+    const uint8_t* restrict refait = lot->refait;
+    unsigned int nbRefaits = 0;
+    uint8_t x, y, nb;
+
+    for (unsigned int k = debut; k < fin; k++)
+        nbRefaits += refait[k];
+    if (nbRefaits == 0)
+        return;
+
+    for (size_t c = 0; c < NB_CASES; c++) { //champ vide et tuiles
+        unsigned char* restrict vue = lot->vue + c * n;
+        unsigned char* restrict mines = lot->mines + c * n;
+
+        for (unsigned int k = debut; k < fin; k++) {
+            uint8_t choisi = -refait[k];
+
+            vue[k] = (vue[k] & ~choisi) | (TUILE & choisi);
+            mines[k] = (mines[k] & ~choisi) | (' ' & choisi);
+        }
+    }
+
+    for (unsigned int k = debut; k < fin; k++) { //mines, dans l'ordre de rempliMines()
+        if (!refait[k])
+            continue;
+        hasard_germe(lot->hasard[k]);
+        for (nb = lot->nbMines[k]; nb > 0;) {
+            x = hasard() % NB_COL;
+            y = hasard() % NB_LIGNE;
+            if (lot->mines[(y * NB_COL + x) * n + k] != MINE) {
+                lot->mines[(y * NB_COL + x) * n + k] = MINE;
+                nb--;
+            }
+        }
+        lot->hasard[k] = hasard_etat();
+    }
+
+    for (unsigned int i = 0; i < NB_LIGNE; i++) { //chiffres, comme metToucheCombien(): mines de chaque colonne sur 3 lignes, puis 3 colonnes
+        const unsigned char* restrict haut = lot->mines + VOISIN_MIN(i) * NB_COL * n;
+        const unsigned char* restrict centre = lot->mines + i * NB_COL * n;
+        const unsigned char* restrict bas = lot->mines + VOISIN_MAX(i, NB_LIGNE) * NB_COL * n;
+
+        for (unsigned int j = 0; j < NB_COL; j++) { //une ligne voisine hors du champ est remplace par la ligne i, compte 0 fois
+            uint8_t* restrict colonne = lot->colonnes + j * n;
+            size_t d = j * n;
+
+            for (unsigned int k = debut; k < fin; k++)
+                colonne[k] = (centre[d + k] == MINE) + ((haut[d + k] == MINE) & (i > 0))
+                        + ((bas[d + k] == MINE) & (i < NB_LIGNE - 1));
+        }
+        for (unsigned int j = 0; j < NB_COL; j++) {
+            unsigned char* restrict mines = lot->mines + (i * NB_COL + j) * n;
+            const uint8_t* restrict gauche = lot->colonnes + VOISIN_MIN(j) * n;
+            const uint8_t* restrict milieu = lot->colonnes + j * n;
+            const uint8_t* restrict droite = lot->colonnes + VOISIN_MAX(j, NB_COL) * n;
+            uint8_t bordG = j > 0, bordD = j < NB_COL - 1; //1 si la colonne voisine existe
+
+            for (unsigned int k = debut; k < fin; k++) {
+                uint8_t total = milieu[k] + (gauche[k] & -bordG) + (droite[k] & -bordD);
+                uint8_t choisi = -(uint8_t) (refait[k] & (mines[k] != MINE));
+                unsigned char chiffre = total == 0 ? ' ' : '0' + total;
+
+                mines[k] = (mines[k] & ~choisi) | (chiffre & choisi);
+            }
+        }
+    }
+}
+
+/*
+ * @brief Copie un champ dans l'tat du jeu du fil (m_tabVue, m_tabMines).
+ * @param const Lot* lot Le lot
+ * @param unsigned int k Le champ
+ * @return rien
+ */
+static void lot_sort(const Lot* lot, unsigned int k)
+{
+    for (size_t c = 0; c < NB_CASES; c++) {
+        m_tabVue[c / NB_COL][c % NB_COL] = lot->vue[c * lot->pas + k];
+        m_tabMines[c / NB_COL][c % NB_COL] = lot->mines[c * lot->pas + k];
+    }
+}
+
+/*
+ * @brief Copie m_tabVue dans un champ du lot, aprs un coup de regles.c:
+ * les mines n'ont pas chang.
+ * @param Lot* lot Le lot
+ * @param unsigned int k Le champ
+ * @return rien
+ */
+static void lot_rangeVue(Lot* lot, unsigned int k)
+{
+    for (size_t c = 0; c < NB_CASES; c++)
+        lot->vue[c * lot->pas + k] = m_tabVue[c / NB_COL][c % NB_COL];
+}
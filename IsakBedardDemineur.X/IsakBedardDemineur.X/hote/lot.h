@@ -0,0 +1,77 @@
+/**
+ * @file   lot.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Lots de parties sur l'ordinateur: N champs jous d'un coup, un
+ * coup par champ  chaque appel, pour les joueurs automatiques qui
+ * apprennent sur des milliers de parties  la fois.
+ *
+ * Les champs sont rangs par case (structure de tableaux): la case c de
+ * tous les champs est contigu. Le dvoilement autour d'une case vide et la
+ * vrification de victoire (demine() et gagne() de regles.c) sont alors des
+ * boucles sans branche sur les champs, que le compilateur vectorise, comme
+ * les chiffres d'une nouvelle partie (metToucheCombien()). Le cas rare, un
+ * accord (devoileAutour()) qui ouvre une zone vide, passe par regles.c
+ * elle-mme, sur un champ copi dans l'tat du jeu du fil. Les rsultats
+ * sont ceux de la commande 'D' du PIC: une partie termine est aussitt
+ * remplace, avec les mines que rempliMines() aurait tires.
+ * Les champs sont rpartis entre les fils en tranches contigus.
+ *
+ * Les vues (observations) ont les octets de la commande 'V' (TUILE,
+ * DRAPEAU, espace ou chiffre ASCII), rangs par case comme le lot: la case
+ * c du champ k est vues[c * nbChamps + k], o c = ligne * NB_COL + colonne.
+ * Un tableau de vues a NB_CASES * nbChamps octets.
+ */
+
+#ifndef LOT_H
+#define	LOT_H
+
+#include <stdint.h>  // pour les types de taille fixe (uint8_t)
+
+typedef struct Lot Lot;
+
+/**
+ * @brief Alloue un lot. Les champs sont vides jusqu' lot_reinitialise().
+ * @param nbChamps Nombre de champs
+ * @param nbFils Fils d'excution (le fil appelant compte pour un)
+ * @return le lot, NULL si la mmoire manque
+ */
+Lot* lot_cree(unsigned int nbChamps, unsigned int nbFils);
+
+/**
+ * @brief Arrte les fils et libre le lot.
+ * @param lot Le lot
+ */
+void lot_detruit(Lot* lot);
+
+/**
+ * @brief Commence une nouvelle partie sur chaque champ (reset_batch), comme
+ * preparePartie() hors mode sans devinette.
+ * @param lot Le lot
+ * @param germes Germe de hasard() de chaque champ
+ * @param nbMines Nombre de mines de chaque champ
+ * @param vues Reoit les vues, ou NULL
+ */
+void lot_reinitialise(Lot* lot, const unsigned int* germes, const uint8_t* nbMines, unsigned char* vues);
+
+/**
+ * @brief Dvoile une case par champ (reveal_batch), comme joue() suivi de
+ * preparePartie() si la partie est termine.
+ * @param lot Le lot
+ * @param x, y Colonne et ligne de chaque champ ( partir de 1, dj valides)
+ * @param resultats Reoit PARTIE_EN_COURS, PARTIE_GAGNEE ou PARTIE_PERDUE
+ * pour chaque champ
+ * @param vues Reoit les vues aprs le coup, ou NULL
+ */
+void lot_devoile(Lot* lot, const uint8_t* x, const uint8_t* y, char* resultats, unsigned char* vues);
+
+/**
+ * @brief Met ou enlve un drapeau sur une case par champ (flag_batch),
+ * comme metOuEnleveDrapeau().
+ * @param lot Le lot
+ * @param x, y Colonne et ligne de chaque champ ( partir de 1, dj valides)
+ * @param vues Reoit les vues aprs le coup, ou NULL
+ */
+void lot_drapeau(Lot* lot, const uint8_t* x, const uint8_t* y, unsigned char* vues);
+
+#endif	/* LOT_H */
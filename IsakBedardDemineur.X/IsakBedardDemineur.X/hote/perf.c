@@ -0,0 +1,566 @@
+/**
+ * @file   perf.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Mesures de performance du jeu sur l'ordinateur, avec comparaison
+ *  une rfrence enregistre: les mtriques de la commande 'P' du PIC
+ * (mesure.h), plus une partie enregistre rejoue au complet.
+ *
+ * Usage: perf [-n essais] [-r enregistrement] [-c reference] [-s seuil]
+ *        perf -d reponse        (rponse de 'P' du PIC en mode comparaison)
+ *        perf -p reponse [-s seuil] > commande
+ *  -n  essais par mtrique (101 par dfaut, au plus NB_MAX_ESSAIS)
+ *  -r  partie rejoue par la mtrique "partie" (partie.enr par dfaut)
+ *  -c  compare  une rponse de perf enregistre (perf.reference)
+ *  -s  hausse tolre du p50 en pourcentage (10 par dfaut)
+ *  -d  vrifie une rponse du PIC: retourne 1 si elle finit par "ok":false
+ *  -p  crit la commande 'P' en mode comparaison (commande.h) avec les p50
+ *      d'une rponse du PIC comme rfrences,  envoyer sur le port srie
+ *
+ * Le jeu est celui du PIC (partie.c, regles.c, Lcd4Lignes.c sur la carte
+ * mule, carte.c). Chaque essai mesure chaque mtrique sur les mmes
+ * NB_CHAMPS champs de MINES_PERF mines (germes 1  NB_CHAMPS), comme
+ * mesure.c: les dures sont en ns par champ, copie du champ de dpart
+ * comprise. "affichage" compte aussi les octets crits au LCD par
+ * afficheTabVue() sur les NB_CHAMPS champs, et "partie" les ticks et les
+ * octets du LCD d'un rejeu de l'enregistrement (comme hote/rejeu). Rponse
+ * (une ligne JSON, toujours dans le mme ordre):
+ *  {"unite":"ns","essais":101,"champs":256,"mines":9,
+ *   "generation":{"min":..,"p50":..,"p90":..,"p99":..,"max":..}, ... ,
+ *   "affichage":{..,"lcd_octets":..},"partie":{..,"ticks":..,"lcd_octets":..}}
+ * Avec -c, une deuxime ligne compare chaque mtrique  la rfrence:
+ *  {"reference":"perf.reference","seuil":10,
+ *   "generation":{"p50":..,"reference":..,"regression":false}, ... ,"ok":true}
+ * Une mtrique rgresse si son p50 dpasse celui de la rfrence de plus du
+ * seuil, ou si un de ses comptes (ticks, lcd_octets) n'est plus le mme:
+ * perf retourne alors 1. La premire ligne peut servir de nouvelle
+ * rfrence. Les dures dpendent de l'ordinateur: une rfrence se refait
+ * sur l'ordinateur qui compare (make reference), les comptes non.
+ */
+
+#define _POSIX_C_SOURCE 199309L //clock_gettime()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../demineur.h"
+#include "../hasard.h"
+#include "../Lcd4Lignes.h"
+#include "carte.h"
+
+#define NB_CHAMPS 256 //champs de chaque essai
+#define MINES_PERF 9 //comme MINES_MESURE (mesure.c)
+#define REJEUX_PAR_ESSAI 4 //rejeux de la partie enregistre par essai
+#define NB_ESSAIS_DEFAUT 101
+#define NB_ESSAIS_CHAUFFE 20 //essais non compts au dbut
+#define NB_MAX_ESSAIS 1001
+#define SEUIL_DEFAUT 10
+#define TAILLE_LIGNE 4096
+
+#define NB_MESURES 7
+#define NB_METRIQUES_PIC 6 //NB_METRIQUES de mesure.h: les 6 premires mesures
+#define MESURE_AFFICHAGE 3
+#define MESURE_PARTIE 6
+
+static double perf_generation(void);
+static double perf_devoile(void);
+static double perf_gagne(void);
+static double perf_affichage(void);
+static double perf_chiffre(void);
+static double perf_accord(void);
+static double perf_partie(void);
+
+/*
+ * Les mesures, dans l'ordre de mesure.h pour les six premires.
+ */
+static const char* const m_noms[NB_MESURES] = {"generation", "devoile", "gagne", "affichage", "chiffre", "accord", "partie"};
+static double (*const m_mesures[NB_MESURES])(void) = {
+    perf_generation, perf_devoile, perf_gagne, perf_affichage, perf_chiffre, perf_accord, perf_partie
+};
+
+static char m_mines[NB_CHAMPS][NB_LIGNE][NB_COL + 1]; //m_tabMines de chaque champ
+static char m_vueDevoilee[NB_CHAMPS][NB_LIGNE][NB_COL + 1]; //m_tabVue aprs "devoile"
+static char m_vueAccord[NB_CHAMPS][NB_LIGNE][NB_COL + 1]; //chiffre dvoil et drapeaux sur ses mines voisines
+static uint8_t m_vide[NB_CHAMPS][2]; //premire case vide de chaque champ (x, y)
+static uint8_t m_chiffre[NB_CHAMPS][2]; //premier chiffre de chaque champ (x, y)
+static Enregistrement m_enr;
+static unsigned long m_octetsAffichage; //octets crits au LCD par "affichage"
+static unsigned long m_octetsPartie; //octets crits au LCD par un rejeu
+static double m_durees[NB_MESURES][NB_MAX_ESSAIS];
+static volatile int m_puits; //empche le compilateur de supprimer les appels
+
+static void perf_prepare(void);
+static void perf_premiereCase(bool chiffre, uint8_t* x, uint8_t* y);
+static bool perf_compare(const char* reference, unsigned int seuil, const double* p50);
+static int perf_verifiePic(const char* fichier);
+static int perf_commandePic(const char* fichier, unsigned int seuil);
+static bool perf_litLigne(const char* fichier, char* ligne);
+static const char* perf_objet(const char* ligne, const char* nom);
+static bool perf_valeur(const char* ligne, const char* nom, const char* cle, double* valeur);
+static double perf_centile(const double* durees, int nbEssais, int pourcentage);
+static int perf_trie(const void* a, const void* b);
+static double perf_maintenant(void);
+
+int main(int argc, char** argv)
+{
+    int nbEssais = NB_ESSAIS_DEFAUT;
+    unsigned int seuil = SEUIL_DEFAUT;
+    const char* enregistrement = "partie.enr";
+    const char* reference = NULL;
+    const char* reponsePic = NULL;
+    bool commande = false;
+    double p50[NB_MESURES];
+    FILE* entree;
+    bool ok;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:r:c:s:d:p:")) != -1) {
+        switch (opt) {
+            case 'n':
+                nbEssais = atoi(optarg);
+                break;
+            case 'r':
+                enregistrement = optarg;
+                break;
+            case 'c':
+                reference = optarg;
+                break;
+            case 's':
+                seuil = atoi(optarg);
+                break;
+            case 'd':
+                reponsePic = optarg;
+                break;
+            case 'p':
+                reponsePic = optarg;
+                commande = true;
+                break;
+            default:
+                fprintf(stderr, "usage: perf [-n essais] [-r enregistrement] [-c reference] [-s seuil]\n"
+                        "       perf -d reponse | perf -p reponse [-s seuil]\n");
+                return 2;
+        }
+    }
+    if (nbEssais < 1 || nbEssais > NB_MAX_ESSAIS || seuil > 255) {
+        fprintf(stderr, "perf: options invalides\n");
+        return 2;
+    }
+    if (reponsePic != NULL)
+        return commande ? perf_commandePic(reponsePic, seuil) : perf_verifiePic(reponsePic);
+
+    if ((entree = fopen(enregistrement, "rb")) == NULL) {
+        perror(enregistrement);
+        return 2;
+    }
+    if (!carte_litEnregistrement(entree, &m_enr)) {
+        fprintf(stderr, "perf: %s n'est pas un enregistrement complet\n", enregistrement);
+        return 2;
+    }
+    fclose(entree);
+    perf_prepare();
+
+    for (int e = 0; e < NB_ESSAIS_CHAUFFE; e++) //caches et frquence du processeur en rgime
+        for (int m = 0; m < NB_MESURES; m++)
+            m_mesures[m]();
+    for (int e = 0; e < nbEssais; e++) //mtriques entrelaces: une drive de l'ordinateur les touche toutes
+        for (int m = 0; m < NB_MESURES; m++)
+            m_durees[m][e] = m_mesures[m]();
+
+    printf("{\"unite\":\"ns\",\"essais\":%d,\"champs\":%d,\"mines\":%d", nbEssais, NB_CHAMPS, MINES_PERF);
+    for (int m = 0; m < NB_MESURES; m++) {
+        qsort(m_durees[m], nbEssais, sizeof m_durees[m][0], perf_trie);
+        p50[m] = perf_centile(m_durees[m], nbEssais, 50);
+        printf(",\"%s\":{\"min\":%.1f,\"p50\":%.1f,\"p90\":%.1f,\"p99\":%.1f,\"max\":%.1f", m_noms[m],
+               m_durees[m][0], p50[m], perf_centile(m_durees[m], nbEssais, 90),
+               perf_centile(m_durees[m], nbEssais, 99), m_durees[m][nbEssais - 1]);
+        if (m == MESURE_AFFICHAGE)
+            printf(",\"lcd_octets\":%lu", m_octetsAffichage);
+        if (m == MESURE_PARTIE)
+            printf(",\"ticks\":%lu,\"lcd_octets\":%lu", m_enr.nbTicks, m_octetsPartie);
+        printf("}");
+    }
+    printf("}\n");
+    ok = (reference == NULL) || perf_compare(reference, seuil, p50);
+    carte_libere(&m_enr);
+    return ok ? 0 : 1;
+}
+
+/*
+ * @brief Gnre les champs des essais et les tats de dpart des
+ * mtriques, sans mesurer.
+ * @param rien
+ * @return rien
+ */
+static void perf_prepare(void)
+{
+    uint8_t x, y;
+
+    for (int c = 0; c < NB_CHAMPS; c++) {
+        hasard_germe(c + 1);
+        rempliMines(MINES_PERF);
+        metToucheCombien();
+        memcpy(m_mines[c], m_tabMines, sizeof m_tabMines);
+
+        initTabVue();
+        perf_premiereCase(false, &x, &y);
+        m_vide[c][0] = x;
+        m_vide[c][1] = y;
+        demine(x, y);
+        memcpy(m_vueDevoilee[c], m_tabVue, sizeof m_tabVue);
+
+        initTabVue();
+        perf_premiereCase(true, &x, &y);
+        m_chiffre[c][0] = x;
+        m_chiffre[c][1] = y;
+        demine(x, y);
+        for (char j = VOISIN_MIN(y - 1); j <= VOISIN_MAX(y - 1, NB_LIGNE); j++)
+            for (char i = VOISIN_MIN(x - 1); i <= VOISIN_MAX(x - 1, NB_COL); i++)
+                if (m_tabMines[j][i] == MINE)
+                    m_tabVue[j][i] = DRAPEAU; //les drapeaux du joueur, tous bien placs
+        memcpy(m_vueAccord[c], m_tabVue, sizeof m_tabVue);
+    }
+    lcd_init(); //LCD mul prt pour "affichage"
+}
+
+/*
+ * @brief Cherche la premire case vide ou le premier chiffre de m_tabMines,
+ * comme mesure_essai() et mesure_chiffre(): (1, 1) s'il n'y en a pas.
+ * @param bool chiffre Vrai pour un chiffre, faux pour une case vide
+ * @param uint8_t* x, uint8_t* y Reoivent la case ( partir de 1)
+ * @return rien
+ */
+static void perf_premiereCase(bool chiffre, uint8_t* x, uint8_t* y)
+{
+    char car;
+
+    for (uint8_t j = 0; j < NB_LIGNE; j++) {
+        for (uint8_t i = 0; i < NB_COL; i++) {
+            car = m_tabMines[j][i];
+            if (chiffre ? (car != ' ' && car != MINE) : car == ' ') {
+                *x = i + 1;
+                *y = j + 1;
+                return;
+            }
+        }
+    }
+    *x = 1;
+    *y = 1;
+}
+
+/*
+ * @brief rempliMines() + metToucheCombien() sur chaque champ.
+ * @param rien
+ * @return la dure moyenne par champ, en ns
+ */
+static double perf_generation(void)
+{
+    double debut = perf_maintenant();
+
+    for (int c = 0; c < NB_CHAMPS; c++) {
+        hasard_germe(c + 1);
+        rempliMines(MINES_PERF);
+        metToucheCombien();
+    }
+    return (perf_maintenant() - debut) / NB_CHAMPS;
+}
+
+/*
+ * @brief demine() sur la premire case vide de chaque champ, vue pleine de
+ * tuiles.
+ * @param rien
+ * @return la dure moyenne par champ, en ns
+ */
+static double perf_devoile(void)
+{
+    double debut = perf_maintenant();
+
+    for (int c = 0; c < NB_CHAMPS; c++) {
+        memcpy(m_tabMines, m_mines[c], sizeof m_tabMines);
+        initTabVue();
+        m_puits += demine(m_vide[c][0], m_vide[c][1]);
+    }
+    return (perf_maintenant() - debut) / NB_CHAMPS;
+}
+
+/*
+ * @brief gagne() sur la vue de chaque champ aprs "devoile".
+ * @param rien
+ * @return la dure moyenne par champ, en ns
+ */
+static double perf_gagne(void)
+{
+    double debut = perf_maintenant();
+
+    for (int c = 0; c < NB_CHAMPS; c++) {
+        memcpy(m_tabVue, m_vueDevoilee[c], sizeof m_tabVue);
+        m_partie.nbMines = MINES_PERF; //gagne() l'augmente si le champ est gagn
+        m_puits += gagne();
+    }
+    return (perf_maintenant() - debut) / NB_CHAMPS;
+}
+
+/*
+ * @brief afficheTabVue() de la vue de chaque champ aprs "devoile", sur le
+ * LCD mul. Compte les octets crits au LCD.
+ * @param rien
+ * @return la dure moyenne par champ, en ns
+ */
+static double perf_affichage(void)
+{
+    unsigned int ecritures = m_nbEcrituresLcd;
+    double debut = perf_maintenant();
+
+    for (int c = 0; c < NB_CHAMPS; c++) {
+        memcpy(m_tabVue, m_vueDevoilee[c], sizeof m_tabVue);
+        afficheTabVue();
+    }
+    debut = perf_maintenant() - debut;
+    m_octetsAffichage = (m_nbEcrituresLcd - ecritures) & 0xFFFF; //unsigned int de 16 bits sur le PIC
+    return debut / NB_CHAMPS;
+}
+
+/*
+ * @brief demine() sur le premier chiffre de chaque champ (une seule case).
+ * @param rien
+ * @return la dure moyenne par champ, en ns
+ */
+static double perf_chiffre(void)
+{
+    double debut = perf_maintenant();
+
+    for (int c = 0; c < NB_CHAMPS; c++) {
+        memcpy(m_tabMines, m_mines[c], sizeof m_tabMines);
+        initTabVue();
+        m_puits += demine(m_chiffre[c][0], m_chiffre[c][1]);
+    }
+    return (perf_maintenant() - debut) / NB_CHAMPS;
+}
+
+/*
+ * @brief demine() sur le chiffre dvoil de chaque champ, un drapeau sur
+ * chaque mine voisine: dvoile les voisines et ouvre les zones vides.
+ * @param rien
+ * @return la dure moyenne par champ, en ns
+ */
+static double perf_accord(void)
+{
+    double debut = perf_maintenant();
+
+    for (int c = 0; c < NB_CHAMPS; c++) {
+        memcpy(m_tabMines, m_mines[c], sizeof m_tabMines);
+        memcpy(m_tabVue, m_vueAccord[c], sizeof m_tabVue);
+        m_puits += demine(m_chiffre[c][0], m_chiffre[c][1]);
+    }
+    return (perf_maintenant() - debut) / NB_CHAMPS;
+}
+
+/*
+ * @brief Rejoue la partie enregistre REJEUX_PAR_ESSAI fois (carte.c).
+ * @param rien
+ * @return la dure moyenne d'un rejeu, en ns
+ */
+static double perf_partie(void)
+{
+    double debut = perf_maintenant();
+
+    for (int r = 0; r < REJEUX_PAR_ESSAI; r++)
+        m_octetsPartie = carte_rejoue(&m_enr);
+    return (perf_maintenant() - debut) / REJEUX_PAR_ESSAI;
+}
+
+/*
+ * @brief Compare les p50 et les comptes  la rfrence et envoie la ligne
+ * de comparaison.
+ * @param const char* reference Le fichier de rfrence
+ * @param unsigned int seuil Hausse tolre en pourcentage
+ * @param const double* p50 Le p50 de chaque mesure
+ * @return vrai si aucune mtrique n'a rgress
+ */
+static bool perf_compare(const char* reference, unsigned int seuil, const double* p50)
+{
+    static char ligne[TAILLE_LIGNE];
+    double valeurs[NB_MESURES][3]; //p50, puis les comptes
+    bool regressions[NB_MESURES];
+    bool ok = true;
+
+    if (!perf_litLigne(reference, ligne))
+        return false;
+    for (int m = 0; m < NB_MESURES; m++) {
+        if (!perf_valeur(ligne, m_noms[m], "p50", &valeurs[m][0])
+                || (m == MESURE_AFFICHAGE && !perf_valeur(ligne, m_noms[m], "lcd_octets", &valeurs[m][1]))
+                || (m == MESURE_PARTIE && (!perf_valeur(ligne, m_noms[m], "ticks", &valeurs[m][1])
+                                           || !perf_valeur(ligne, m_noms[m], "lcd_octets", &valeurs[m][2])))) {
+            fprintf(stderr, "perf: %s: pas de %s complet\n", reference, m_noms[m]);
+            return false;
+        }
+    }
+
+    printf("{\"reference\":\"%s\",\"seuil\":%u", reference, seuil);
+    for (int m = 0; m < NB_MESURES; m++) {
+        regressions[m] = p50[m] * 100 > valeurs[m][0] * (100 + seuil);
+        if (m == MESURE_AFFICHAGE && m_octetsAffichage != valeurs[m][1]) {
+            fprintf(stderr, "perf: affichage: %lu octets au LCD au lieu de %.0f\n", m_octetsAffichage, valeurs[m][1]);
+            regressions[m] = true;
+        }
+        if (m == MESURE_PARTIE && (m_enr.nbTicks != valeurs[m][1] || m_octetsPartie != valeurs[m][2])) {
+            fprintf(stderr, "perf: partie: %lu ticks et %lu octets au LCD au lieu de %.0f et %.0f\n",
+                    m_enr.nbTicks, m_octetsPartie, valeurs[m][1], valeurs[m][2]);
+            regressions[m] = true;
+        }
+        printf(",\"%s\":{\"p50\":%.1f,\"reference\":%.1f,\"regression\":%s}", m_noms[m],
+               p50[m], valeurs[m][0], regressions[m] ? "true" : "false");
+        if (regressions[m])
+            ok = false;
+    }
+    printf(",\"ok\":%s}\n", ok ? "true" : "false");
+    return ok;
+}
+
+/*
+ * @brief Vrifie une rponse du PIC  'P' en mode comparaison (mesure.h)
+ * et nomme les mtriques qui ont rgress.
+ * @param const char* fichier La rponse enregistre
+ * @return 0 si "ok":true, 1 si "ok":false, 2 si ce n'est pas une rponse
+ * du mode comparaison
+ */
+static int perf_verifiePic(const char* fichier)
+{
+    static char ligne[TAILLE_LIGNE];
+    double regression;
+
+    if (!perf_litLigne(fichier, ligne))
+        return 2;
+    for (int m = 0; m < NB_METRIQUES_PIC; m++)
+        if (perf_valeur(ligne, m_noms[m], "regression", &regression) && regression != 0)
+            printf("perf: %s a regresse sur le PIC\n", m_noms[m]);
+    if (strstr(ligne, "\"ok\":false") != NULL)
+        return 1;
+    if (strstr(ligne, "\"ok\":true") != NULL)
+        return 0;
+    fprintf(stderr, "perf: %s n'est pas une reponse de 'P' en mode comparaison\n", fichier);
+    return 2;
+}
+
+/*
+ * @brief crit la commande 'P' en mode comparaison (commande.h): seuil,
+ * puis le p50 de chaque mtrique de la rponse du PIC, sur 4 octets, poids
+ * fort d'abord.
+ * @param const char* fichier Une rponse du PIC  'P'
+ * @param unsigned int seuil Hausse tolre en pourcentage
+ * @return 0, ou 2 si la rponse est incomplte
+ */
+static int perf_commandePic(const char* fichier, unsigned int seuil)
+{
+    static char ligne[TAILLE_LIGNE];
+    unsigned char commande[3 + 4 * NB_METRIQUES_PIC] = {'P', 1, seuil};
+    unsigned long p50;
+    double valeur;
+
+    if (!perf_litLigne(fichier, ligne))
+        return 2;
+    for (int m = 0; m < NB_METRIQUES_PIC; m++) {
+        if (!perf_valeur(ligne, m_noms[m], "p50", &valeur)) {
+            fprintf(stderr, "perf: %s: pas de p50 pour %s\n", fichier, m_noms[m]);
+            return 2;
+        }
+        p50 = (unsigned long) valeur;
+        for (int i = 0; i < 4; i++)
+            commande[3 + 4 * m + i] = p50 >> (24 - 8 * i);
+    }
+    fwrite(commande, 1, sizeof commande, stdout);
+    return 0;
+}
+
+/*
+ * @brief Lit la premire ligne d'un fichier.
+ * @param const char* fichier Le fichier
+ * @param char* ligne Reoit la ligne (TAILLE_LIGNE octets)
+ * @return faux si le fichier ne peut pas tre lu
+ */
+static bool perf_litLigne(const char* fichier, char* ligne)
+{
+    FILE* entree = fopen(fichier, "r");
+
+    if (entree == NULL || fgets(ligne, TAILLE_LIGNE, entree) == NULL) {
+        perror(fichier);
+        if (entree != NULL)
+            fclose(entree);
+        return false;
+    }
+    fclose(entree);
+    return true;
+}
+
+/*
+ * @brief Cherche l'objet d'une mtrique dans une ligne JSON.
+ * @param const char* ligne La ligne
+ * @param const char* nom Le nom de la mtrique
+ * @return le dbut de l'objet (aprs "nom":{), NULL s'il n'y est pas
+ */
+static const char* perf_objet(const char* ligne, const char* nom)
+{
+    char cle[64];
+    const char* objet;
+
+    snprintf(cle, sizeof cle, "\"%s\":{", nom);
+    objet = strstr(ligne, cle);
+    return (objet == NULL) ? NULL : objet + strlen(cle);
+}
+
+/*
+ * @brief Lit une valeur de l'objet d'une mtrique.
+ * @param const char* ligne La ligne JSON
+ * @param const char* nom, const char* cle La mtrique et la valeur
+ * @param double* valeur Reoit la valeur (true: 1, false: 0)
+ * @return faux si la valeur n'est pas dans l'objet
+ */
+static bool perf_valeur(const char* ligne, const char* nom, const char* cle, double* valeur)
+{
+    const char* objet = perf_objet(ligne, nom);
+    const char* fin;
+    const char* trouve;
+    char motif[64];
+
+    if (objet == NULL || (fin = strchr(objet, '}')) == NULL)
+        return false;
+    snprintf(motif, sizeof motif, "\"%s\":", cle);
+    if ((trouve = strstr(objet, motif)) == NULL || trouve > fin)
+        return false;
+    trouve += strlen(motif);
+    *valeur = (strncmp(trouve, "true", 4) == 0) ? 1 : strtod(trouve, NULL); //false donne 0
+    return true;
+}
+
+/*
+ * @brief Donne un centile de dures tries: la plus petite dure au-dessus
+ * de laquelle il reste moins de (100 - pourcentage) % des essais.
+ * @param const double* durees Les dures tries
+ * @param int nbEssais Le nombre de dures
+ * @param int pourcentage 50, 90 ou 99
+ * @return le centile
+ */
+static double perf_centile(const double* durees, int nbEssais, int pourcentage)
+{
+    return durees[(nbEssais * pourcentage + 99) / 100 - 1];
+}
+
+static int perf_trie(const void* a, const void* b)
+{
+    double x = *(const double*) a, y = *(const double*) b;
+
+    return (x > y) - (x < y);
+}
+
+/*
+ * @brief Temps monotone.
+ * @param rien
+ * @return le temps en ns
+ */
+static double perf_maintenant(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
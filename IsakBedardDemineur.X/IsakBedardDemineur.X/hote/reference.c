@@ -0,0 +1,133 @@
+/**
+ * @file   reference.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Rgles de taille variable, telles qu'avant leur spcialisation.
+ * Voir reference.h.
+ *
+ * La seule diffrence avec l'ancien code du PIC: calculToucheCombien() lisait
+ * la case m_tabMines[i][-1] pour la colonne 0. Ici la colonne est borne
+ * comme la ligne.
+ */
+
+#include <stdlib.h>
+#include "../demineur.h"
+#include "reference.h"
+
+static int reference_compte(const char* mines, int nbLignes, int nbCol, int largeur,
+                            int ligne, int colonne);
+
+/*
+ * @brief Calcule les chiffres du champ. Voir reference.h.
+ * @param mines, nbLignes, nbCol, largeur Voir reference.h
+ * @return rien
+ */
+void reference_chiffres(char* mines, int nbLignes, int nbCol, int largeur)
+{
+    int nb;
+
+    for (int i = 0; i < nbLignes; i++) {
+        for (int j = 0; j < nbCol; j++) {
+            if (mines[i * largeur + j] != MINE) {
+                nb = reference_compte(mines, nbLignes, nbCol, largeur, i, j);
+                mines[i * largeur + j] = (nb == 0) ? ' ' : nb + '0';
+            }
+        }
+    }
+}
+
+/*
+ * @brief Dvoile le 3x3 autour d'une case. Voir reference.h.
+ * @param vue, mines, nbLignes, nbCol, largeur, x, y Voir reference.h
+ * @return vrai si au moins une tuile a t enleve
+ */
+bool reference_enleveTuilesAutour(char* vue, const char* mines, int nbLignes, int nbCol,
+                                  int largeur, int x, int y)
+{
+    bool enleve = false;
+
+    for (int j = y - 2; j <= y; j++) {
+        for (int i = x - 2; i <= x; i++) {
+            if (j < 0 || j >= nbLignes || i < 0 || i >= nbCol)
+                continue;
+            if (mines[j * largeur + i] != MINE && vue[j * largeur + i] != DRAPEAU) {
+                if (vue[j * largeur + i] == TUILE)
+                    enleve = true;
+                vue[j * largeur + i] = mines[j * largeur + i];
+            }
+        }
+    }
+    return enleve;
+}
+
+/*
+ * @brief Joue un accord, avec une file pour les zones vides. Voir reference.h.
+ * @param vue, mines, nbLignes, nbCol, largeur, x, y Voir reference.h
+ * @return faux si une mine a t touche
+ */
+bool reference_accord(char* vue, const char* mines, int nbLignes, int nbCol,
+                      int largeur, int x, int y)
+{
+    int* file = malloc(nbLignes * nbCol * sizeof(int)); //cases vides dvoiles,  ouvrir
+    int debut = 0, fin = 0, nbDrapeaux = 0, k;
+    bool touche = false;
+
+    for (int j = y - 2; j <= y; j++)
+        for (int i = x - 2; i <= x; i++)
+            if (j >= 0 && j < nbLignes && i >= 0 && i < nbCol && vue[j * largeur + i] == DRAPEAU)
+                nbDrapeaux++;
+    if (nbDrapeaux != mines[(y - 1) * largeur + x - 1] - '0') {
+        free(file);
+        return true;
+    }
+    for (int j = y - 2; j <= y; j++) {
+        for (int i = x - 2; i <= x; i++) {
+            if (j >= 0 && j < nbLignes && i >= 0 && i < nbCol && vue[j * largeur + i] == TUILE
+                && mines[j * largeur + i] == MINE) {
+                vue[j * largeur + i] = MINE_EXPLOSEE;
+                touche = true;
+            }
+        }
+    }
+    if (touche) {
+        free(file);
+        return false;
+    }
+    file[fin++] = (y - 1) * nbCol + x - 1; //le chiffre ouvre son 3x3 comme une case vide
+    while (debut < fin) {
+        k = file[debut++];
+        for (int j = k / nbCol - 1; j <= k / nbCol + 1; j++) {
+            for (int i = k % nbCol - 1; i <= k % nbCol + 1; i++) {
+                if (j < 0 || j >= nbLignes || i < 0 || i >= nbCol)
+                    continue;
+                if (vue[j * largeur + i] == TUILE && mines[j * largeur + i] != MINE) {
+                    vue[j * largeur + i] = mines[j * largeur + i];
+                    if (mines[j * largeur + i] == ' ')
+                        file[fin++] = j * nbCol + i;
+                }
+            }
+        }
+    }
+    free(file);
+    return true;
+}
+
+/*
+ * @brief Compte les mines du 3x3 autour d'une case (calculToucheCombien()).
+ * @param mines, nbLignes, nbCol, largeur Voir reference.h
+ * @param ligne, colonne La case,  partir de 0
+ * @return le nombre de mines autour
+ */
+static int reference_compte(const char* mines, int nbLignes, int nbCol, int largeur,
+                            int ligne, int colonne)
+{
+    int nb = 0;
+
+    for (int i = ligne - 1; i <= ligne + 1; i++) {
+        for (int j = colonne - 1; j <= colonne + 1; j++) {
+            if (i >= 0 && i < nbLignes && j >= 0 && j < nbCol && mines[i * largeur + j] == MINE)
+                nb++;
+        }
+    }
+    return nb;
+}
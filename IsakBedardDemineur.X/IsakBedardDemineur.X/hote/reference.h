@@ -0,0 +1,52 @@
+/**
+ * @file   reference.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Version de rfrence des rgles, de taille variable, pour le banc
+ * d'essai sur l'ordinateur.
+ *
+ * Ce sont les fonctions du jeu d'avant la spcialisation sur NB_LIGNE x
+ * NB_COL (calculToucheCombien() et l'ancien enleveTuilesAutour()): un 3x3
+ * autour de chaque case, avec une vrification des bords pour chaque voisine.
+ * Le nombre de lignes et de colonnes est un paramtre. Les cases ont le mme
+ * sens que dans m_tabMines et m_tabVue; une ligne occupe `largeur` octets.
+ */
+
+#ifndef REFERENCE_H
+#define	REFERENCE_H
+
+#include <stdbool.h>  // pour l'utilisation du type bool
+
+/**
+ * @brief Calcule les chiffres d'un champ qui ne contient que des mines et
+ * des espaces (comme metToucheCombien()).
+ * @param mines Le champ, nbLignes lignes de largeur octets
+ * @param nbLignes, nbCol, largeur Taille du champ
+ */
+void reference_chiffres(char* mines, int nbLignes, int nbCol, int largeur);
+
+/**
+ * @brief Dvoile les cases sans mine et sans drapeau du 3x3 autour d'une
+ * case (comme enleveTuilesAutour()).
+ * @param vue, mines Les deux tableaux, mmes dimensions
+ * @param nbLignes, nbCol, largeur Taille du champ
+ * @param x, y La case,  partir de 1
+ * @return vrai si au moins une tuile a t enleve
+ */
+bool reference_enleveTuilesAutour(char* vue, const char* mines, int nbLignes, int nbCol,
+                                  int largeur, int x, int y);
+
+/**
+ * @brief Joue un accord sur un chiffre dvoil (comme demine() sur un
+ * chiffre): si le nombre de drapeaux voisins gale le chiffre, dvoile les
+ * voisines, puis ouvre en largeur les zones vides dvoiles par ce coup
+ * seulement. Une mine voisine sans drapeau devient MINE_EXPLOSEE.
+ * @param vue, mines Les deux tableaux, mmes dimensions
+ * @param nbLignes, nbCol, largeur Taille du champ
+ * @param x, y Le chiffre,  partir de 1
+ * @return faux si une mine a t touche
+ */
+bool reference_accord(char* vue, const char* mines, int nbLignes, int nbCol,
+                      int largeur, int x, int y);
+
+#endif	/* REFERENCE_H */
@@ -0,0 +1,120 @@
+/**
+ * @file   rejeu.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Rejoue sur l'ordinateur un enregistrement des entres fait sur le
+ * PIC (commande 'E', format dans entrees.h).
+ *
+ * Usage: rejeu enregistrement [-a attendu | -t tick]
+ * Le jeu lui-mme (partie.c, regles.c, solveur.c, hasard.c, Lcd4Lignes.c)
+ * est celui du PIC, sur une carte mule (carte.c). Le gnrateur hasard()
+ * est le mme: le germe de l'entte donne les mmes champs. Rponse (une
+ * ligne JSON), avec les mmes valeurs que le rapport de rejeu du PIC
+ * (mesure.h):
+ *  {"rejeu":"fin","ticks":..,"lcd_octets":..,
+ *   "etat":{"x":..,"y":..,"mines":..,"champ":..,"vue":..}}
+ * Avec -a, la rponse est compare  la premire ligne du fichier attendu
+ * (par exemple le rapport du PIC sans ses champs en cycles): retourne 1 si
+ * elle diffre.
+ *
+ * Avec -t, seul le tick donn est mesur (numrot comme m_noTick, le
+ * "tick" d'un dpassement de la commande 'J', voir moniteur.h): le rejeu
+ * s'arrte  la fin de ce tick et donne ses entres, les octets crits au
+ * LCD, le temps de chaque tche sur l'ordinateur et la plus longue, puis
+ * l'tat aprs le tick:
+ *  {"rejeu":"tick","tick":..,"entrees":..,"lcd_octets":..,
+ *   "ns":{"entrees":..,"deplace":..,...},"tache":"..",
+ *   "etat":{"x":..,"y":..,"mines":..,"champ":..,"vue":..}}
+ * Retourne 1 si le tick n'est pas dans l'enregistrement.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../demineur.h"
+#include "../masque.h"
+#include "carte.h"
+
+#define TAILLE_LIGNE 256
+
+static const char* const m_nomsTaches[NB_TACHES] = {"entrees", "deplace", "joue", "drapeau", "affichage", "partie", "commande"}; //comme moniteur.c
+
+static int rejeu_tick(const Enregistrement* enr, unsigned long noTick);
+
+int main(int argc, char** argv)
+{
+    Enregistrement enr;
+    FILE* entree;
+    char ligne[TAILLE_LIGNE], attendu[TAILLE_LIGNE];
+    unsigned long nbOctets;
+
+    if (argc != 2 && (argc != 4 || (strcmp(argv[2], "-a") != 0 && strcmp(argv[2], "-t") != 0))) {
+        fprintf(stderr, "usage: rejeu enregistrement [-a attendu | -t tick]\n");
+        return 2;
+    }
+    if ((entree = fopen(argv[1], "rb")) == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    if (!carte_litEnregistrement(entree, &enr)) {
+        fprintf(stderr, "rejeu: %s n'est pas un enregistrement complet\n", argv[1]);
+        return 1;
+    }
+    fclose(entree);
+    if (argc == 4 && strcmp(argv[2], "-t") == 0) {
+        nbOctets = rejeu_tick(&enr, strtoul(argv[3], NULL, 0));
+        carte_libere(&enr);
+        return nbOctets;
+    }
+
+    nbOctets = carte_rejoue(&enr);
+    snprintf(ligne, sizeof ligne, "{\"rejeu\":\"fin\",\"ticks\":%lu,\"lcd_octets\":%lu,"
+             "\"etat\":{\"x\":%d,\"y\":%d,\"mines\":%d,\"champ\":%u,\"vue\":%u}}",
+             enr.nbTicks, nbOctets, m_partie.x, m_partie.y, m_partie.nbMines,
+             masque_hacheChamp(), masque_hacheVue());
+    puts(ligne);
+    carte_libere(&enr);
+
+    if (argc == 4) {
+        if ((entree = fopen(argv[3], "r")) == NULL || fgets(attendu, sizeof attendu, entree) == NULL) {
+            perror(argv[3]);
+            return 1;
+        }
+        fclose(entree);
+        attendu[strcspn(attendu, "\r\n")] = 0;
+        if (strcmp(ligne, attendu) != 0) {
+            printf("rejeu: attendu %s\n", attendu);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * @brief Rejoue jusqu' la fin d'un tick et envoie ce qu'il a fait.
+ * @param const Enregistrement* enr L'enregistrement
+ * @param unsigned long noTick Le tick
+ * @return 0, ou 1 si le tick n'est pas dans l'enregistrement
+ */
+static int rejeu_tick(const Enregistrement* enr, unsigned long noTick)
+{
+    TickRejoue tick;
+    unsigned char pire = 0; //tche la plus longue, comme moniteur_finTick()
+
+    if (!carte_rejoueTick(enr, noTick, &tick)) {
+        fprintf(stderr, "rejeu: le tick %lu n'est pas dans l'enregistrement (%lu a %lu)\n",
+                noTick, enr->tickDepart, enr->tickDepart + enr->nbTicks - 1);
+        return 1;
+    }
+    printf("{\"rejeu\":\"tick\",\"tick\":%lu,\"entrees\":%u,\"lcd_octets\":%lu,\"ns\":{",
+           noTick, tick.etat, tick.lcdOctets);
+    for (unsigned char t = 0; t < NB_TACHES; t++) {
+        printf("%s\"%s\":%.0f", (t != 0) ? "," : "", m_nomsTaches[t], tick.ns[t]);
+        if (t != 0 && tick.ns[t] > tick.ns[pire])
+            pire = t;
+    }
+    printf("},\"tache\":\"%s\",\"etat\":{\"x\":%d,\"y\":%d,\"mines\":%d,\"champ\":%u,\"vue\":%u}}\n",
+           m_nomsTaches[pire], m_partie.x, m_partie.y, m_partie.nbMines,
+           masque_hacheChamp(), masque_hacheVue());
+    return 0;
+}
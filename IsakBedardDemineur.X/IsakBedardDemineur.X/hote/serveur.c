@@ -0,0 +1,687 @@
+/**
+ * @file   serveur.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Serveur de parties sur l'ordinateur: des milliers de parties
+ * indpendantes, une par connexion sur un socket Unix, avec les commandes
+ * de jeu du PIC (commande.h). Remplace une tagre de cartes pour les
+ * joueurs automatiques.
+ *
+ * Usage: serveur [-s socket] [-f fils] [-c sessions] [-m mines] [-d]
+ *  -s  chemin du socket (demineur.sock par dfaut)
+ *  -f  fils de jeu (par dfaut: un par coeur)
+ *  -c  sessions simultanes au plus (4096 par dfaut); les connexions en
+ *      trop sont fermes aussitt
+ *  -m  mines de la premire partie de chaque session (NB_MINES_DEPART)
+ *  -d  mode sans devinette (m_sansDevinette)
+ *
+ * Commandes: 'L', 'D', 'M', 'V' et 'B' ont le format et les rponses de
+ * commande.h. Les parties sont joues par partie.c et regles.c, comme sur
+ * le PIC, mais sans LCD. Un lot 'B' est lu en entier avant d'tre jou: le
+ * contrle de flux d'un coup  la fois ne sert qu'au tampon de rception du
+ * PIC, un client peut donc envoyer tout le lot d'un coup (attendre chaque
+ * rponse reste correct). Les commandes de la carte ('E', 'F', 'R', 'S',
+ * 'P', 'W', 'T', 'J', 'G') sont refuses comme pendant un enregistrement:
+ * leurs donnes sont lues et la rponse est REFUS. Les commandes inconnues
+ * sont ignores.
+ *
+ * Organisation:
+ *  - le fil principal attend sur epoll le socket d'coute et toutes les
+ *    connexions. Il accepte les connexions et passe les octets reus, en
+ *    messages, au fil de jeu qui possde la session (numro de session
+ *    modulo le nombre de fils), par une file sans verrou (file.h);
+ *  - chaque fil de jeu est seul  toucher ses sessions: il assemble les
+ *    commandes, les joue et crit les rponses dans le socket, sans verrou.
+ *    Un fil sans message s'endort sur un eventfd, que le fil principal ne
+ *    signale que s'il dort.
+ * Chaque session a son arne, alloue une fois au dmarrage: tat de la
+ * partie, tampons d'entre et de sortie. L'tat du jeu de partie.c est
+ * global (LOCAL_FIL, un par fil): le fil y copie la session qu'il joue et
+ * ne la remet dans l'arne qu'en passant  une autre session. Rien n'est
+ * allou par coup ni par connexion.
+ *
+ *  l'arrt (SIGINT, SIGTERM), une ligne JSON:
+ *  {"serveur":"arret","fils":..,"sessions":..,"commandes":..,"coups":..}
+ * o sessions compte les connexions acceptes. La charge se mesure avec
+ * charge.c (coups par seconde, latence).
+ */
+
+#define _GNU_SOURCE //accept4(), eventfd()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "../demineur.h"
+#include "../masque.h"
+#include "../hasard.h"
+#include "../mesure.h"
+#include "file.h"
+
+#define CMD_CHARGE 'L' //commandes de commande.c
+#define CMD_ENREGISTRE 'E'
+#define CMD_FIN 'F'
+#define CMD_REJOUE 'R'
+#define CMD_STATS 'S'
+#define CMD_DEVOILE 'D'
+#define CMD_DRAPEAU 'M'
+#define CMD_VUE 'V'
+#define CMD_LOT 'B'
+#define CMD_MESURE 'P'
+#define CMD_VEILLE 'W'
+#define CMD_ECHEANCE 'T'
+#define CMD_MONITEUR 'J'
+#define CMD_GENERATION 'G'
+#define REFUS 'X'
+#define SOCKET_DEFAUT "demineur.sock"
+#define SESSIONS_DEFAUT 4096
+#define FILS_MAX 64
+#define TAILLE_FILE 4096 //messages en attente par fil de jeu
+#define TAILLE_MESSAGE 64 //octets lus par recv()
+#define TAILLE_ENTREE 1024 //la plus longue commande ('B' + 255 coups) a 767 octets
+#define TAILLE_SORTIE (256 + NB_CASES) //rponse d'un lot: 255 rsultats et la vue
+#define NB_EVENEMENTS 64 //vnements par epoll_wait()
+#define ECOUTE UINT32_MAX //numro d'vnement du socket d'coute
+#define MSG_OUVRE (-1) //longueurs spciales des messages
+#define MSG_FERME (-2)
+
+/*
+ * Message du fil principal  un fil de jeu.
+ */
+typedef struct {
+    uint32_t session;
+    int longueur; //octets reus, MSG_OUVRE ou MSG_FERME
+    unsigned char octets[TAILLE_MESSAGE];
+} Message;
+
+/*
+ * Arne d'une session. socket et hasard sont crits par le fil principal
+ * avant MSG_OUVRE; ensuite, seul le fil de jeu touche la session.
+ */
+typedef struct {
+    int socket;
+    Partie partie;
+    char tabVue[NB_LIGNE][NB_COL + 1];
+    char tabMines[NB_LIGNE][NB_COL + 1];
+    unsigned int hasard; //tat de hasard() de la session
+    unsigned char entree[TAILLE_ENTREE]; //commande incomplte
+    size_t nbEntree;
+    unsigned char sortie[TAILLE_SORTIE]; //rponses pas encore envoyes
+    size_t nbSortie;
+} Session;
+
+/*
+ * Un fil de jeu et ses compteurs, lus aprs pthread_join().
+ */
+typedef struct {
+    pthread_t fil;
+    File* messages;
+    int reveil; //eventfd signal quand un message arrive pendant que le fil dort
+    atomic_bool endormi;
+    Session* chargee; //session copie dans l'tat du jeu du fil
+    long nbCommandes, nbCoups;
+} FilJeu;
+
+static Session* m_sessions;
+static unsigned int m_nbSessions = SESSIONS_DEFAUT;
+static File* m_libres; //numros des sessions libres
+static FilJeu m_fils[FILS_MAX];
+static int m_nbFils;
+static int m_nbMines = NB_MINES_DEPART; //vrifi avant de passer dans m_partie (8 bits)
+static bool m_modeSansDevinette;
+static unsigned int m_nbConnexions; //connexions acceptes, donne le germe de chaque session
+static atomic_bool m_arret;
+
+static void serveur_arrete(int signal);
+static void serveur_ecoute(int ecoute);
+static void serveur_accepte(int epoll, int ecoute);
+static void serveur_lit(int epoll, uint32_t noSession);
+static void serveur_passe(const Message* message);
+static void* serveur_joue(void* arg);
+static void serveur_traite(FilJeu* fil, const Message* message);
+static void serveur_charge(FilJeu* fil, Session* session);
+static void serveur_commandes(FilJeu* fil, Session* session);
+static size_t serveur_longueur(const unsigned char* commande, size_t nbOctets);
+static void serveur_execute(FilJeu* fil, Session* session, const unsigned char* commande);
+static void serveur_chargeChamp(Session* session, const unsigned char* trame);
+static char serveur_action(char action, uint8_t x, uint8_t y);
+static bool serveur_caseValide(uint8_t x, uint8_t y);
+static void serveur_vue(Session* session);
+static void serveur_putch(Session* session, char c);
+static void serveur_envoie(Session* session);
+
+int main(int argc, char** argv)
+{
+    const char* chemin = SOCKET_DEFAUT;
+    long nbFils = sysconf(_SC_NPROCESSORS_ONLN);
+    struct sockaddr_un adresse = {.sun_family = AF_UNIX};
+    struct sigaction action = {.sa_handler = serveur_arrete};
+    sigset_t arret;
+    long nbCommandes = 0, nbCoups = 0;
+    int ecoute, opt;
+
+    while ((opt = getopt(argc, argv, "s:f:c:m:d")) != -1) {
+        switch (opt) {
+            case 's':
+                chemin = optarg;
+                break;
+            case 'f':
+                nbFils = atol(optarg);
+                break;
+            case 'c':
+                m_nbSessions = atol(optarg);
+                break;
+            case 'm':
+                m_nbMines = atoi(optarg);
+                break;
+            case 'd':
+                m_modeSansDevinette = true;
+                break;
+            default:
+                fprintf(stderr, "usage: serveur [-s socket] [-f fils] [-c sessions] [-m mines] [-d]\n");
+                return 2;
+        }
+    }
+    if (nbFils < 1)
+        nbFils = 1;
+    if (nbFils > FILS_MAX)
+        nbFils = FILS_MAX;
+    m_nbFils = nbFils;
+    if (m_nbSessions < 1 || m_nbMines < 0 || m_nbMines > NB_CASES || strlen(chemin) >= sizeof adresse.sun_path) {
+        fprintf(stderr, "serveur: options invalides\n");
+        return 2;
+    }
+
+    m_sessions = calloc(m_nbSessions, sizeof *m_sessions); //toutes les arnes, une fois
+    m_libres = file_cree(m_nbSessions, sizeof(uint32_t));
+    if (m_sessions == NULL || m_libres == NULL) {
+        fprintf(stderr, "serveur: memoire insuffisante\n");
+        return 1;
+    }
+    for (uint32_t i = 0; i < m_nbSessions; i++)
+        file_ajoute(m_libres, &i);
+
+    strcpy(adresse.sun_path, chemin);
+    unlink(chemin);
+    ecoute = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (ecoute < 0 || bind(ecoute, (struct sockaddr*) &adresse, sizeof adresse) != 0
+            || listen(ecoute, SOMAXCONN) != 0) {
+        perror(chemin);
+        return 1;
+    }
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    sigemptyset(&arret);
+    sigaddset(&arret, SIGINT);
+    sigaddset(&arret, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &arret, NULL); //les fils de jeu hritent du masque: le signal interrompt epoll_wait()
+
+    for (int f = 0; f < m_nbFils; f++) {
+        m_fils[f].messages = file_cree(TAILLE_FILE, sizeof(Message));
+        m_fils[f].reveil = eventfd(0, EFD_CLOEXEC);
+        if (m_fils[f].messages == NULL || m_fils[f].reveil < 0) {
+            fprintf(stderr, "serveur: memoire insuffisante\n");
+            return 1;
+        }
+        pthread_create(&m_fils[f].fil, NULL, serveur_joue, &m_fils[f]);
+    }
+    pthread_sigmask(SIG_UNBLOCK, &arret, NULL);
+
+    serveur_ecoute(ecoute);
+
+    for (int f = 0; f < m_nbFils; f++) {
+        uint64_t un = 1;
+
+        if (write(m_fils[f].reveil, &un, sizeof un) < 0) //le fil revoit m_arret
+            perror("eventfd");
+        pthread_join(m_fils[f].fil, NULL);
+        nbCommandes += m_fils[f].nbCommandes;
+        nbCoups += m_fils[f].nbCoups;
+    }
+    close(ecoute);
+    unlink(chemin);
+    printf("{\"serveur\":\"arret\",\"fils\":%d,\"sessions\":%u,\"commandes\":%ld,\"coups\":%ld}\n",
+            m_nbFils, m_nbConnexions, nbCommandes, nbCoups);
+    return 0;
+}
+
+/*
+ * @brief Demande l'arrt du serveur (SIGINT, SIGTERM).
+ * @param int signal Le signal reu
+ * @return rien
+ */
+static void serveur_arrete(int signal)
+{
+    atomic_store(&m_arret, true);
+}
+
+/*
+ * @brief Boucle du fil principal: attend les connexions et les octets
+ * reus jusqu' l'arrt.
+ * @param int ecoute Le socket d'coute, non bloquant
+ * @return rien
+ */
+static void serveur_ecoute(int ecoute)
+{
+    struct epoll_event evenements[NB_EVENEMENTS];
+    struct epoll_event evenement = {.events = EPOLLIN, .data.u32 = ECOUTE};
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    int nb;
+
+    epoll_ctl(epoll, EPOLL_CTL_ADD, ecoute, &evenement);
+    while (!atomic_load(&m_arret)) {
+        nb = epoll_wait(epoll, evenements, NB_EVENEMENTS, -1); //interrompu par le signal d'arrt
+        for (int i = 0; i < nb; i++) {
+            if (evenements[i].data.u32 == ECOUTE)
+                serveur_accepte(epoll, ecoute);
+            else
+                serveur_lit(epoll, evenements[i].data.u32);
+        }
+    }
+    close(epoll);
+}
+
+/*
+ * @brief Accepte les connexions en attente. Chacune reoit une session
+ * libre, que son fil de jeu prpare  la rception de MSG_OUVRE.
+ * @param int epoll, int ecoute L'epoll du fil principal et le socket d'coute
+ * @return rien
+ */
+static void serveur_accepte(int epoll, int ecoute)
+{
+    struct epoll_event evenement = {.events = EPOLLIN};
+    Message message = {.longueur = MSG_OUVRE};
+    int client;
+
+    while ((client = accept4(ecoute, NULL, NULL, SOCK_CLOEXEC)) >= 0) { //bloquant: les fils de jeu crivent sans attendre epoll
+        if (!file_retire(m_libres, &message.session)) {
+            close(client); //toutes les sessions sont prises
+            continue;
+        }
+        m_nbConnexions++;
+        m_sessions[message.session].socket = client;
+        m_sessions[message.session].hasard = m_nbConnexions; //une suite diffrente par connexion
+        serveur_passe(&message); //avant tout octet reu
+        evenement.data.u32 = message.session;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, client, &evenement);
+    }
+}
+
+/*
+ * @brief Lit les octets arrivs sur une connexion et les passe  son fil de
+ * jeu. Une connexion ferme par le client est retire d'epoll; son fil de
+ * jeu ferme le socket et libre la session.
+ * @param int epoll L'epoll du fil principal
+ * @param uint32_t noSession La session de la connexion
+ * @return rien
+ */
+static void serveur_lit(int epoll, uint32_t noSession)
+{
+    Message message = {.session = noSession};
+    int client = m_sessions[noSession].socket;
+    ssize_t nb = recv(client, message.octets, TAILLE_MESSAGE, MSG_DONTWAIT);
+
+    if (nb > 0) {
+        message.longueur = nb; //le reste, s'il y en a, redonne un vnement
+        serveur_passe(&message);
+    } else if (nb == 0 || (errno != EAGAIN && errno != EINTR)) {
+        epoll_ctl(epoll, EPOLL_CTL_DEL, client, NULL);
+        message.longueur = MSG_FERME;
+        serveur_passe(&message);
+    }
+}
+
+/*
+ * @brief Ajoute un message  la file du fil de jeu de sa session et rveille
+ * ce fil s'il dort. Une file pleine est attendue: les fils de jeu ralentissent
+ * ainsi la lecture des sockets.
+ * @param const Message* message Le message
+ * @return rien
+ */
+static void serveur_passe(const Message* message)
+{
+    FilJeu* fil = &m_fils[message->session % m_nbFils];
+    uint64_t un = 1;
+
+    while (!file_ajoute(fil->messages, message))
+        sched_yield();
+    if (atomic_exchange(&fil->endormi, false) && write(fil->reveil, &un, sizeof un) < 0)
+        perror("eventfd");
+}
+
+/*
+ * @brief Boucle d'un fil de jeu: traite ses messages, et dort quand il n'y
+ * en a plus. endormi est mis avant de revoir la file: un message ajout
+ * entre les deux est vu, ou rveille le fil.
+ * @param void* arg Le FilJeu
+ * @return NULL
+ */
+static void* serveur_joue(void* arg)
+{
+    FilJeu* fil = arg;
+    Message message;
+    uint64_t nb;
+
+    m_sansDevinette = m_modeSansDevinette;
+    while (!atomic_load(&m_arret)) {
+        if (file_retire(fil->messages, &message)) {
+            serveur_traite(fil, &message);
+            continue;
+        }
+        atomic_store(&fil->endormi, true);
+        if (file_retire(fil->messages, &message)) {
+            atomic_store(&fil->endormi, false); //un rveil dj envoy ne fera qu'un tour de plus
+            serveur_traite(fil, &message);
+        } else if (read(fil->reveil, &nb, sizeof nb) < 0)
+            perror("eventfd");
+    }
+    return NULL;
+}
+
+/*
+ * @brief Traite un message: nouvelle session, octets reus ou fin de la
+ * connexion.
+ * @param FilJeu* fil Le fil de jeu
+ * @param const Message* message Le message
+ * @return rien
+ */
+static void serveur_traite(FilJeu* fil, const Message* message)
+{
+    Session* session = &m_sessions[message->session];
+
+    switch (message->longueur) {
+        case MSG_OUVRE: //premire partie, comme au dmarrage du PIC
+            serveur_charge(fil, session); //l'arne de l'ancienne session est crase
+            hasard_germe(session->hasard);
+            session->nbEntree = 0;
+            session->nbSortie = 0;
+            m_partie.x = X_DEPART;
+            m_partie.y = Y_DEPART;
+            m_partie.nbMines = m_nbMines;
+            preparePartie();
+            break;
+        case MSG_FERME:
+            if (fil->chargee == session)
+                fil->chargee = NULL; //rien  garder
+            close(session->socket);
+            file_ajoute(m_libres, &message->session); //jamais pleine: une place par session
+            break;
+        default:
+            if (session->nbEntree + message->longueur > TAILLE_ENTREE) {
+                session->nbEntree = 0; //impossible avec des commandes valides: on repart  zro
+                break;
+            }
+            memcpy(session->entree + session->nbEntree, message->octets, message->longueur);
+            session->nbEntree += message->longueur;
+            serveur_commandes(fil, session);
+            break;
+    }
+}
+
+/*
+ * @brief Place une session dans l'tat du jeu du fil (m_partie, m_tabVue,
+ * m_tabMines, hasard()), aprs avoir remis la session prcdente dans son
+ * arne.
+ * @param FilJeu* fil Le fil de jeu
+ * @param Session* session La session  jouer
+ * @return rien
+ */
+static void serveur_charge(FilJeu* fil, Session* session)
+{
+    Session* precedente = fil->chargee;
+
+    if (precedente == session)
+        return;
+    if (precedente != NULL) {
+        precedente->partie = m_partie;
+        memcpy(precedente->tabVue, m_tabVue, sizeof m_tabVue);
+        memcpy(precedente->tabMines, m_tabMines, sizeof m_tabMines);
+        precedente->hasard = hasard_etat();
+    }
+    m_partie = session->partie;
+    memcpy(m_tabVue, session->tabVue, sizeof m_tabVue);
+    memcpy(m_tabMines, session->tabMines, sizeof m_tabMines);
+    hasard_germe(session->hasard);
+    fil->chargee = session;
+}
+
+/*
+ * @brief Excute les commandes compltes de l'entre d'une session, garde
+ * la commande incomplte et envoie les rponses.
+ * @param FilJeu* fil Le fil de jeu
+ * @param Session* session La session
+ * @return rien
+ */
+static void serveur_commandes(FilJeu* fil, Session* session)
+{
+    size_t lus = 0, longueur;
+
+    while ((longueur = serveur_longueur(session->entree + lus, session->nbEntree - lus)) != 0) {
+        serveur_charge(fil, session);
+        serveur_execute(fil, session, session->entree + lus);
+        lus += longueur;
+    }
+    session->nbEntree -= lus;
+    memmove(session->entree, session->entree + lus, session->nbEntree);
+    serveur_envoie(session);
+}
+
+/*
+ * @brief Longueur de la commande au dbut de l'entre.
+ * @param const unsigned char* commande Les octets reus
+ * @param size_t nbOctets Le nombre d'octets reus
+ * @return la longueur de la commande, donnes comprises, ou 0 si elle n'est
+ * pas encore complte
+ */
+static size_t serveur_longueur(const unsigned char* commande, size_t nbOctets)
+{
+    size_t longueur = 1; //commande sans donnes, ou inconnue
+
+    if (nbOctets == 0)
+        return 0;
+    switch (commande[0]) {
+        case CMD_CHARGE:
+            longueur = 2 + NB_OCTETS_MASQUE; //masque et CRC-8
+            break;
+        case CMD_REJOUE:
+            longueur = 5; //germe, nombre de mines et mode
+            break;
+        case CMD_DEVOILE:
+        case CMD_DRAPEAU:
+            longueur = 3; //colonne et ligne
+            break;
+        case CMD_ECHEANCE:
+        case CMD_GENERATION:
+            longueur = 2;
+            break;
+        case CMD_MESURE:
+            if (nbOctets < 2)
+                return 0;
+            longueur = commande[1] != 0 ? 3 + 4 * NB_METRIQUES : 2; //seuil et rfrences en comparaison
+            break;
+        case CMD_LOT:
+            if (nbOctets < 2)
+                return 0;
+            longueur = 2 + 3 * (size_t) commande[1]; //action, colonne et ligne par coup
+            break;
+    }
+    return nbOctets >= longueur ? longueur : 0;
+}
+
+/*
+ * @brief Excute une commande complte de la session charge, comme
+ * commande_traite().
+ * @param FilJeu* fil Le fil de jeu
+ * @param Session* session La session
+ * @param const unsigned char* commande La commande et ses donnes
+ * @return rien
+ */
+static void serveur_execute(FilJeu* fil, Session* session, const unsigned char* commande)
+{
+    const unsigned char* coup;
+
+    fil->nbCommandes++;
+    switch (commande[0]) {
+        case CMD_CHARGE:
+            serveur_chargeChamp(session, commande + 1);
+            break;
+        case CMD_DEVOILE:
+        case CMD_DRAPEAU:
+            if (!serveur_caseValide(commande[1], commande[2])) {
+                for (const char* c = "ERR\r\n"; *c != '\0'; c++)
+                    serveur_putch(session, *c);
+                break;
+            }
+            serveur_putch(session, serveur_action(commande[0], commande[1], commande[2]));
+            fil->nbCoups++;
+            break;
+        case CMD_LOT:
+            for (unsigned int k = 0; k < commande[1]; k++) {
+                coup = commande + 2 + 3 * k;
+                if (serveur_caseValide(coup[1], coup[2]) && (coup[0] == CMD_DEVOILE || coup[0] == CMD_DRAPEAU)) {
+                    serveur_putch(session, serveur_action(coup[0], coup[1], coup[2]));
+                    fil->nbCoups++;
+                } else
+                    serveur_putch(session, REFUS);
+            }
+            serveur_vue(session);
+            break;
+        case CMD_VUE:
+            serveur_vue(session);
+            break;
+        case CMD_ENREGISTRE:
+        case CMD_FIN:
+        case CMD_REJOUE:
+        case CMD_STATS:
+        case CMD_MESURE:
+        case CMD_VEILLE:
+        case CMD_ECHEANCE:
+        case CMD_MONITEUR:
+        case CMD_GENERATION:
+            serveur_putch(session, REFUS); //commandes de la carte
+            break;
+    }
+}
+
+/*
+ * @brief Charge un champ compact, comme commande_charge(): chiffres,
+ * premire case vide dvoile, puis "OK hhhh\r\n" avec le hachage du champ,
+ * ou "ERR\r\n" si le CRC-8 est mauvais.
+ * @param Session* session La session
+ * @param const unsigned char* trame Le masque et son CRC-8
+ * @return rien
+ */
+static void serveur_chargeChamp(Session* session, const unsigned char* trame)
+{
+    char reponse[12];
+    uint8_t x = 1, y = 1;
+
+    if (trame[NB_OCTETS_MASQUE] != masque_crc8(trame, NB_OCTETS_MASQUE))
+        strcpy(reponse, "ERR\r\n");
+    else {
+        m_partie.nbMines = masque_decompacte(trame);
+        m_partie.garanti = true;
+        metToucheCombien();
+        initTabVue();
+        while (y <= NB_LIGNE && m_tabMines[y - 1][x - 1] != ' ') {
+            x++;
+            if (x > NB_COL) {
+                x = 1;
+                y++;
+            }
+        }
+        if (y <= NB_LIGNE)
+            enleveTuilesAutour(x, y);
+        snprintf(reponse, sizeof reponse, "OK %04X\r\n", masque_hacheChamp());
+    }
+    for (char* c = reponse; *c != '\0'; c++)
+        serveur_putch(session, *c);
+}
+
+/*
+ * @brief Joue un coup, comme commande_action(): une partie termine est
+ * aussitt remplace par une nouvelle.
+ * @param char action CMD_DEVOILE ou CMD_DRAPEAU
+ * @param uint8_t x, uint8_t y La case, dj valide
+ * @return PARTIE_EN_COURS, PARTIE_GAGNEE ou PARTIE_PERDUE
+ */
+static char serveur_action(char action, uint8_t x, uint8_t y)
+{
+    char resultat = PARTIE_EN_COURS;
+
+    if (action == CMD_DEVOILE) {
+        resultat = joue(x, y);
+        if (resultat != PARTIE_EN_COURS)
+            preparePartie();
+    } else
+        metOuEnleveDrapeau(x, y);
+    return resultat;
+}
+
+/*
+ * @brief Vrifie qu'une case reue est dans le champ.
+ * @param uint8_t x, uint8_t y La colonne et la ligne,  partir de 1
+ * @return vrai si la case est valide
+ */
+static bool serveur_caseValide(uint8_t x, uint8_t y)
+{
+    return x >= 1 && x <= NB_COL && y >= 1 && y <= NB_LIGNE;
+}
+
+/*
+ * @brief Ajoute m_tabVue aux rponses, ligne par ligne, sans les '\0'.
+ * @param Session* session La session
+ * @return rien
+ */
+static void serveur_vue(Session* session)
+{
+    for (int i = 0; i < NB_LIGNE; i++)
+        for (int j = 0; j < NB_COL; j++)
+            serveur_putch(session, m_tabVue[i][j]);
+}
+
+/*
+ * @brief Ajoute un octet aux rponses de la session, en envoyant d'abord
+ * les rponses si le tampon est plein.
+ * @param Session* session La session
+ * @param char c L'octet
+ * @return rien
+ */
+static void serveur_putch(Session* session, char c)
+{
+    if (session->nbSortie == TAILLE_SORTIE)
+        serveur_envoie(session);
+    session->sortie[session->nbSortie++] = c;
+}
+
+/*
+ * @brief Envoie les rponses de la session. Le socket est bloquant: un
+ * client qui ne lit pas ses rponses ne retarde que les sessions de ce fil.
+ * Si le client est parti, les rponses sont perdues et le fil principal
+ * verra la fermeture.
+ * @param Session* session La session
+ * @return rien
+ */
+static void serveur_envoie(Session* session)
+{
+    size_t envoyes = 0;
+    ssize_t nb;
+
+    while (envoyes < session->nbSortie) {
+        nb = send(session->socket, session->sortie + envoyes, session->nbSortie - envoyes, MSG_NOSIGNAL);
+        if (nb < 0 && errno == EINTR)
+            continue;
+        if (nb <= 0)
+            break;
+        envoyes += nb;
+    }
+    session->nbSortie = 0;
+}
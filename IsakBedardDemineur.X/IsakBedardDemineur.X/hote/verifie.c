@@ -0,0 +1,162 @@
+/**
+ * @file   verifie.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Vrifie sur l'ordinateur que les rgles du PIC (regles.c) donnent
+ * exactement les mmes tableaux que la version de rfrence (reference.c).
+ *
+ * Usage: verifie [nombre de champs]   (20000 par dfaut)
+ * Chaque champ a de 0  40 mines au hasard. On compare:
+ *  - les chiffres de metToucheCombien();
+ *  - m_tabVue et le rsultat de enleveTuilesAutour() sur une case au hasard,
+ *    avec des drapeaux et des cases dj dvoiles au hasard;
+ *  - m_tabVue et le rsultat de demine() sur un chiffre dj dvoil
+ *    (accord), avec des drapeaux sur ses mines voisines la plupart du temps.
+ * Retourne 0 si tout est identique, 1  la premire diffrence.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../demineur.h"
+#include "reference.h"
+
+static bool verifie_chiffres(void);
+static bool verifie_enleve(void);
+static bool verifie_accord(void);
+static void verifie_afficheChamp(const char tab[NB_LIGNE][NB_COL + 1]);
+
+int main(int argc, char** argv)
+{
+    long nbChamps = (argc > 1) ? atol(argv[1]) : 20000;
+
+    srand(1);
+    for (long k = 0; k < nbChamps; k++) {
+        initTabVue();
+        rempliMines(rand() % 41);
+        if (!verifie_chiffres() || !verifie_enleve() || !verifie_accord()) {
+            printf("verifie: difference au champ %ld\n", k);
+            return 1;
+        }
+    }
+    printf("verifie: %ld champs %dx%d identiques\n", nbChamps, NB_LIGNE, NB_COL);
+    return 0;
+}
+
+/*
+ * @brief Compare metToucheCombien()  la rfrence sur le champ courant, qui
+ * ne contient que des mines et des espaces.
+ * @param rien
+ * @return vrai si les chiffres sont identiques
+ */
+static bool verifie_chiffres(void)
+{
+    char attendu[NB_LIGNE][NB_COL + 1];
+
+    memcpy(attendu, m_tabMines, sizeof attendu);
+    reference_chiffres(&attendu[0][0], NB_LIGNE, NB_COL, NB_COL + 1);
+    metToucheCombien();
+    if (memcmp(attendu, m_tabMines, sizeof attendu) == 0)
+        return true;
+    puts("metToucheCombien, attendu:");
+    verifie_afficheChamp(attendu);
+    puts("obtenu:");
+    verifie_afficheChamp(m_tabMines);
+    return false;
+}
+
+/*
+ * @brief Compare enleveTuilesAutour()  la rfrence sur une vue au hasard.
+ * @param rien
+ * @return vrai si les vues et les rsultats sont identiques
+ */
+static bool verifie_enleve(void)
+{
+    char attendu[NB_LIGNE][NB_COL + 1];
+    uint8_t x = 1 + rand() % NB_COL;
+    uint8_t y = 1 + rand() % NB_LIGNE;
+    bool enleveAttendu;
+    int tirage;
+
+    for (int i = 0; i < NB_LIGNE; i++) {
+        for (int j = 0; j < NB_COL; j++) {
+            tirage = rand() % 6;
+            if (tirage == 0)
+                m_tabVue[i][j] = DRAPEAU;
+            else if (tirage == 1 && m_tabMines[i][j] != MINE)
+                m_tabVue[i][j] = m_tabMines[i][j]; //dj dvoile
+            else
+                m_tabVue[i][j] = TUILE;
+        }
+    }
+    memcpy(attendu, m_tabVue, sizeof attendu);
+    enleveAttendu = reference_enleveTuilesAutour(&attendu[0][0], &m_tabMines[0][0],
+                                                 NB_LIGNE, NB_COL, NB_COL + 1, x, y);
+    if (enleveTuilesAutour(x, y) == enleveAttendu && memcmp(attendu, m_tabVue, sizeof attendu) == 0)
+        return true;
+    printf("enleveTuilesAutour(%d, %d), attendu:\n", x, y);
+    verifie_afficheChamp(attendu);
+    puts("obtenu:");
+    verifie_afficheChamp(m_tabVue);
+    return false;
+}
+
+/*
+ * @brief Compare un accord de demine()  la rfrence. La vue de
+ * verifie_enleve() est reprise; on dvoile un chiffre au hasard et, trois
+ * fois sur quatre, on met un drapeau sur chacune de ses mines voisines.
+ * @param rien
+ * @return vrai si les vues et les rsultats sont identiques
+ */
+static bool verifie_accord(void)
+{
+    char attendu[NB_LIGNE][NB_COL + 1];
+    uint8_t x = 1 + rand() % NB_COL;
+    uint8_t y = 1 + rand() % NB_LIGNE;
+    bool drapeaux = rand() % 4 != 0;
+    bool resultatAttendu;
+
+    for (int n = 0; n < NB_CASES && (m_tabMines[y - 1][x - 1] == ' ' || m_tabMines[y - 1][x - 1] == MINE); n++) {
+        x = x % NB_COL + 1; //case suivante, jusqu' un chiffre
+        if (x == 1)
+            y = y % NB_LIGNE + 1;
+    }
+    if (m_tabMines[y - 1][x - 1] == ' ' || m_tabMines[y - 1][x - 1] == MINE)
+        return true; //aucun chiffre: rien  vrifier
+    m_tabVue[y - 1][x - 1] = m_tabMines[y - 1][x - 1];
+    for (int j = y - 2; j <= y; j++) {
+        for (int i = x - 2; i <= x; i++) {
+            if (drapeaux && j >= 0 && j < NB_LIGNE && i >= 0 && i < NB_COL)
+                m_tabVue[j][i] = (m_tabMines[j][i] == MINE) ? DRAPEAU
+                                 : (m_tabVue[j][i] == DRAPEAU) ? TUILE : m_tabVue[j][i];
+        }
+    }
+    memcpy(attendu, m_tabVue, sizeof attendu);
+    resultatAttendu = reference_accord(&attendu[0][0], &m_tabMines[0][0], NB_LIGNE, NB_COL,
+                                       NB_COL + 1, x, y);
+    if (demine(x, y) == resultatAttendu && memcmp(attendu, m_tabVue, sizeof attendu) == 0)
+        return true;
+    printf("accord demine(%d, %d), attendu:\n", x, y);
+    verifie_afficheChamp(attendu);
+    puts("obtenu:");
+    verifie_afficheChamp(m_tabVue);
+    return false;
+}
+
+/*
+ * @brief Affiche un tableau du jeu: '*' mine, '#' tuile, 'F' drapeau.
+ * @param tab m_tabMines, m_tabVue ou une copie
+ * @return rien
+ */
+static void verifie_afficheChamp(const char tab[NB_LIGNE][NB_COL + 1])
+{
+    char c;
+
+    for (int i = 0; i < NB_LIGNE; i++) {
+        for (int j = 0; j < NB_COL; j++) {
+            c = tab[i][j];
+            putchar(c == MINE ? '*' : c == TUILE ? '#' : c == DRAPEAU ? 'F' : c);
+        }
+        putchar('\n');
+    }
+}
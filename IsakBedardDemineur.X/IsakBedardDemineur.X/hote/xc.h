@@ -0,0 +1,38 @@
+/**
+ * @file   xc.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Registres muls: remplace l'en-tte de XC8 pour compiler
+ * Lcd4Lignes.c sur l'ordinateur (voir carte.c).
+ *
+ * Seuls les registres du LCD existent. PORTD est double: la valeur crite
+ * par le PIC (TRISD  0) et la valeur lue sur le LCD (TRISD  1), toujours
+ * 0. Le LCD mul n'est donc jamais occup, et lcd_busy() lit l'adresse 0:
+ * lcd_ecritChar() ne la compare qu' des adresses qui ont le bit 7  1,
+ * que lcd_busy() ne retourne jamais, sur le PIC non plus. Les octets crits
+ * sont compts par Lcd4Lignes.c lui-mme (m_nbEcrituresLcd), comme sur le
+ * PIC. Les dlais ne durent rien.
+ */
+
+#ifndef XC_H
+#define	XC_H
+
+typedef struct {
+    unsigned RA0 : 1, RA1 : 1, RA2 : 1, RA3 : 1;
+} PortA;
+
+typedef struct {
+    unsigned TMR1ON : 1;
+} T1Con;
+
+extern PortA PORTAbits; //RS, RW et EN du LCD
+extern T1Con T1CONbits; //Timer1 arrt: lcd_init() utilise __delay_ms()
+extern unsigned char TRISD;
+extern unsigned char m_portD[2]; //[0]: crit par le PIC, [1]: lu sur le LCD
+
+#define PORTD m_portD[TRISD != 0]
+#define NOP()
+#define __delay_us(x)
+#define __delay_ms(x)
+
+#endif	/* XC_H */
@@ -22,69 +22,63 @@
 #include <conio.h>
 #include "Lcd4Lignes.h" // pour utiliser le fichier header lcd4Lignes.h
 #include "serie.h" //pour utiliser le fichier header serie.h
-#include <stdlib.h>
+#include "demineur.h" //constantes et tableaux partags du jeu
+#include "commande.h" //commandes reues par le port srie
+#include "entrees.h" //lecture des entres par tick, enregistrement et rejeu
+#include "stats.h" //statistiques des parties dans l'EEPROM
+#include "veille.h" //horloge des ticks et mise en veille du CPU
+#include "moniteur.h" //chance des ticks (chaque tche est annonce avec moniteur_tache())
+#include "hasard.h" //gnrateur pseudo-alatoire, le mme sur l'ordinateur
 /********************** CONSTANTES *******************************************/
 #define _XTAL_FREQ 1000000 //Constante utilise par __delay_ms(x). Doit = frq interne du uC
-#define NB_LIGNE 4  //afficheur LCD 4x20
-#define NB_COL 20
-#define AXE_X 7  //canal analogique de l'axe x de la manette
-#define AXE_Y 6 //canal analogique de l'axe y de la manette
-#define PORT_SW PORTBbits.RB1 //sw de la manette
-#define SW0 PORTBbits.RB0 //bouton sur la carte noire
-#define TUILE 1 //caractre cgram d'une tuile
-#define MINE 2 //caractre cgram d'une mine
-#define DRAPEAU 3 //caractre cgram d'un drapeau
 /********************** PROTOTYPES *******************************************/
 void initialisation(void);
-void initTabVue(void);
-void rempliMines(int nb);
-void metToucheCombien(void);
-char calculToucheCombien(int ligne, int colonne);
-void deplace(char* x, char* y);
-bool demine(char x, char y);
-void enleveTuilesAutour(char x, char y);
-bool gagne(int* pMines);
-char getAnalog(char canal);
-void afficheTabVue(void);
-void afficheTabMines(void);
-void metOuEnleveDrapeau(char x, char y);
-/****************** VARIABLES GLOBALES ****************************************/
-char m_tabVue[NB_LIGNE][NB_COL + 1]; //Tableau des caractres affichs au LCD
-char m_tabMines[NB_LIGNE][NB_COL + 1]; //Tableau contenant les mines, les espaces et les chiffres
 /******************** PROGRAMME PRINCPAL **************************************/
 void main(void) 
 {
-    char* posX = 10; //pointeur pour la position en X du curseur sur le LCD. Initialis environ au centre.
-    char* posY = 2; //pointeur pour la position en Y du curseur sur le LCD. Initialis environ au centre.
-    int* nbMine = 9; //nombre de mines dans le champ de mines. Augmente de 1 lorsqu'on gagne
-
     initialisation(); //initialisations diverses
-    lcd_init(); //permet la fonctionnalit du LCD
-    initTabVue(); //initialise la matrice m_tabVue avec des tuiles (caractre cgram)
-    rempliMines(nbMine); //initialise partiellement m_tabMines pour placer les mines
-    metToucheCombien(); //place les nombres dans m_tabMines selon l'emplacement des mines
-    afficheTabVue(); //affiche la matrice m_tabVue
+    m_partie.nbMines = stats_init(NB_MINES_DEPART); //reprend la difficult de la dernire partie enregistre
+    INTCONbits.PEIE = 1;
+    INTCONbits.GIE = 1; //interruptions (ticks, rception srie, criture de l'EEPROM en arrire-plan)
+    m_sansDevinette = (entrees_etat() & ENTREE_SW0) != 0; //SW0 enfonc au dmarrage: mode sans devinette
+    preparePartie(); //gnre le champ pendant que le LCD termine sa mise sous tension
+    lcd_init(); //permet la fonctionnalit du LCD. N'attend que ce qui reste des 40 ms
+    afficheTabVue(); //premire image, dj prte dans m_tabVue
+    avertitSansGarantie();
     
     
     while (1) //boucle infinie
     {  
-        deplace(&posX, &posY); //on dplace le curseur
-        if(PORT_SW==0)//si le bouton du joystick est enfonc
-            if(demine(posX,posY)==false || gagne(&nbMine)) //si on a gagn ou perdu (trouv toutes les mines ou touch une mine)
+        traiteTick(); //attend le tick, lit les entres et joue (partie.c)
+        if(kbhit()) //si un caractre est arriv par le port srie
+        {
+            moniteur_tache(TACHE_COMMANDE);
+            if(commande_traite()) //si la commande a recommenc la partie
             {
-                afficheTabMines();
-                while(PORT_SW==1); //on affiche m_tabMines jusqu' ce que le bouton du joystick soit renfonc
-                initTabVue(); 
-                rempliMines(nbMine);
-                metToucheCombien();
-                afficheTabVue(); //on rinitialise les deux matrices.
+                m_partie.x = X_DEPART;
+                m_partie.y = Y_DEPART; //on remet le curseur au centre
             }
-        if(SW0==0) //si le bouton sur la carte noire est enfonc
-            metOuEnleveDrapeau(posX,posY); //appel de la fonction qui gre les drapeaux
-        __delay_ms(100); //dlai de la boucle principale. dtermine la vitesse de dplacement
+        }
     }
 }
 
+/**
+ * @brief Routine d'interruption. Chaque source est traite par son module.
+ * @param Aucun
+ * @return Aucun
+ */
+void __interrupt() interruption(void)
+{
+    if (PIE1bits.TMR2IE && PIR1bits.TMR2IF) //horloge des ticks (20 ms)
+        veille_interruption();
+    if (PIE1bits.TMR1IE && PIR1bits.TMR1IF) //dbordement de l'horloge de 32 bits
+        veille_debordement();
+    if (PIE1bits.RCIE && PIR1bits.RCIF) //caractre reu par le port srie
+        serie_interruption();
+    if (PIE2bits.EEIE && PIR2bits.EEIF) //fin d'criture d'un octet dans l'EEPROM
+        stats_interruption();
+}
+
 /**
  * @brief Fait l'initialisation des diffrents registres et variables.
  * @param Aucun
@@ -97,11 +91,14 @@ void initialisation(void)
     TRISB = 0xFF; //tout le port B en entree
     ANSEL = 0; // PORTA en mode digital. Sur 18F45K20 AN et PortA sont sur les memes broches
     TRISA = 0; //tout le port A en sortie
+    init_serie(); //port srie  9600 bauds. Avant la config analogique puisqu'il remet ANSEL  0
 
     //Pour du vrai hasard, on doit rajouter ces lignes. 
     //Ne fonctionne pas en mode simulateur.
+    T1CONbits.RD16 = 1; //lecture de TMR1 en une seule fois (TMR1H fig  la lecture de TMR1L)
     T1CONbits.TMR1ON = 1;
-    srand(TMR1);
+    hasard_germe(TMR1);
+    veille_init(); //horloge des ticks: Timer2, interruption toutes les 20 ms
     //Configuration du port analogique
     ANSELbits.ANS7 = 1; //A7 en mode analogique
     ADCON0bits.ADON = 1; //Convertisseur AN  on
@@ -110,274 +107,3 @@ void initialisation(void)
     ADCON2bits.ACQT = 0; //7; //20 TAD (on laisse le max de temps au Chold du convertisseur AN pour se charger)
     ADCON2bits.ADCS = 0; //6; //Fosc/64 (Frquence pour la conversion la plus longue possible)
 }
-
-/*
- * @brief Rempli le tableau m_tabVue avec le caractre spcial (dfinie en CGRAM
- *  du LCD) TUILE. Met un '\0'  la fin de chaque ligne pour faciliter affichage
- *  avec lcd_putMessage().
- * @param rien
- * @return rien
- */
-void initTabVue(void) 
-{
-    for (char i = 0; i < NB_LIGNE; i++) {
-        for (char j = 0; j < NB_COL; j++) { 
-            m_tabVue[i][j] = TUILE; //on met des tuiles
-        }
-        m_tabVue[i][NB_COL] = 0; //le dernier caractre de la ligne est 0 ou '\0'
-    }
-}
-
-/*
- * @brief Rempli le tableau m_tabMines d'un nombre (nb) de mines au hasard.
- *  Les cases vides contiendront le code ascii d'un espace et les cases avec
- *  mine contiendront le caractre MINE dfini en CGRAM.
- * @param int nb, le nombre de mines  mettre dans le tableau 
- * @return rien
- */
-void rempliMines(int nb) 
-{
-    char x, y; //les caractres pour la position en XY de la mine
-
-    for (char i = 0; i < NB_LIGNE; i++) {
-        for (char j = 0; j < NB_COL; j++) {
-            m_tabMines[i][j] = ' '; //on met tout le tableau vide (avec des espaces)
-        }
-    }
-    while (nb > 0) { //tant que le nombre de mines voulu n'a pas t atteint
-        x = rand() % 20;
-        y = rand() % 4; //on assigne des valeurs XY alatoires
-        if (m_tabMines[y][x] != MINE) { //si la position alatoire est diponible
-            m_tabMines[y][x] = MINE; //on place une mine
-            nb--; //il reste une mine de moins  placer
-        }
-    }
-}
-
-/*
- * @brief Rempli le tableau m_tabMines avec le nombre de mines que touche la case.
- * Si une case touche  3 mines, alors la mthode place le code ascii de 3 dans
- * le tableau. Si la case ne touche  aucune mine, la mthode met le code
- * ascii d'un espace.
- * Cette mthode utilise calculToucheCombien(). 
- * @param rien
- * @return rien
- */
-void metToucheCombien(void) 
-{
-    for (char i = 0; i < NB_LIGNE; i++) {
-        for (char j = 0; j < NB_COL; j++) {
-            if (m_tabMines[i][j] != MINE)
-                m_tabMines[i][j] = calculToucheCombien(i, j) + 48; //on met le caractre ASCII du nombre de mines autour de la case dans la case
-            if (m_tabMines[i][j] == '0') //s'il y a 0 mines autour (afficherait 0)
-                m_tabMines[i][j] = ' '; //on remplace par un espace pour tre plus fidle au jeu original
-        }
-    }
-}
-
-/*
- * @brief Calcul  combien de mines touche la case. Cette mthode est appele par metToucheCombien()
- * @param int ligne, int colonne La position dans le tableau m_tabMines a vrifier
- * @return char nombre. Le nombre de mines touches par la case
- */
-char calculToucheCombien(int ligne, int colonne) 
-{
-    int i = ligne - 1;
-    int j = colonne - 1;//variables pour faire un 3x3 autour de la case voulue
-    char nbMines = 0; //valeur de retour
-
-    if (i < 0)
-        i = 0;
-    if (j < 0)
-        j = 0;//si on dpasse le LCD, on remet  la limite
-
-    for (i = i; (i <= (ligne + 1))&&(i < NB_LIGNE); i++) {//
-        for (j = j = colonne - 1; (j <= (colonne + 1))&&(j < NB_COL); j++) { //on fait le 3x3 autour de la case voulue.
-                                                                     //on ne le fait pas si on dpasse du LCD
-            if (m_tabMines[i][j] == MINE)//Si c'est une mine                               
-                nbMines++;//incrmentation du nombre de mines
-        }
-    }
-    return nbMines; //on retourne le nombre de mines autour
-}
-
-/**
- * @brief Si la manette est vers la droite ou la gauche, on dplace le curseur 
- * d'une position (gauche, droite, bas et haut)
- * @param char* x, char* y Les positions X et y  sur l'afficheur
- * @return rien
- */
-void deplace(char* x, char* y) 
-{
-    unsigned char analogX = getAnalog(AXE_X);//valeur entre 0 et 255 qui reprsente la position X du joystick
-    unsigned char analogY = getAnalog(AXE_Y);//valeur entre 0 et 255 qui reprsente la position Y du joystick
-
-    if (0 <= analogX && analogX <= 80) //si le joystick est vers la gauche
-    {
-        *x = (*x) - 1; //dcale la position de 1 vers la gauche
-        if ((*x) <= 0) //si on dpasse de l'cran
-            *x = 20; //on revient de l'autre ct
-    } else if (175 <= analogX && analogX <= 255) //si le joystick est vers la droite
-    {
-        *x = (*x) + 1; //dcale la position de 1 vers la droite
-        if ((*x) >= 21) //si on dpasse de l'cran
-            *x = 1; //on revient de l'autre ct
-    }
-
-    if (0 <= analogY && analogY <= 80) //si le joystick est vers le haut
-    {
-        *y = (*y) - 1; //dcale la position de 1 vers le haut
-        if ((*y) <= 0) //si on dpasse de l'cran
-            *y = 4; //on revient de l'autre ct
-    } else if (175 <= analogY && analogY <= 255) //si le joystick est vers le bas
-    {
-        *y = (*y) + 1; //dcale la position de 1 vers le bas
-        if ((*y) >= 5) //si on dpasse de l'cran
-            *y = 1; //on revient de l'autre ct
-    }
-    lcd_gotoXY(*x, *y); //on met le curseur  la nouvelle position.
-}
-
-/*
- * @brief Dvoile une tuile (case) de m_tabVue. 
- * S'il y a une mine, retourne Faux. Sinon remplace la case et les cases autour
- * par ce qu'il y a derrire les tuiles (m_tabMines).
- * Utilise enleveTuileAutour(). Ne dvoile rien si la case slectionne est un drapeau.
- * @param char x, char y Les positions X et y sur l'afficheur LCD
- * @return faux s'il y avait une mine, vrai sinon
- */
-bool demine(char x, char y) 
-{
-    while(PORT_SW==true); //pour laisser le temps de voir si on a gagn ou perdu
-    if (m_tabMines[y - 1][x - 1] == MINE)//si la case slectionne est une mine
-        return false;//retourne faux (on a perdu)
-    else 
-    {
-        if (m_tabMines[y-1][x-1]==' ')//si c'est un espace (donc pas une mine ou pas un chiffre)
-            enleveTuilesAutour(x, y);//on enlve les tuiles autour
-        else if (m_tabVue[y-1][x-1]!=DRAPEAU)//si ce n'est pas un drapeau (donc un chiffre)
-        {
-            m_tabVue[y-1][x-1]=m_tabMines[y-1][x-1];//on actualise seulement la case slectionne, pas celles autour
-            afficheTabVue();//actualise le LCD pour afficher la nouvelle matrice
-        }
-        return true;//retourne vrai (on a pas perdu)
-    }
-}
-
-/*
- * @brief Dvoile les cases non mines autour de la tuile reue en paramtre.
- * Cette mthode est appele par demine(). Ne devoile pas non plus les cases avec
- * drapeaux.
- * @param char x, char y Les positions X et y sur l'afficheur LCD.
- * @return rien
- */
-void enleveTuilesAutour(char x, char y) 
-{
-    signed char i = x - 2;
-    signed char j = y - 2;//variables pour faire un 3x3 autour de la case slectionne
-    char mem; //variable mmoire pour rinitialisation ultrieure
-
-    if (i < 0)
-        i = 0;
-    if (j < 0)
-        j = 0;//si on dpasse du LCD, on revient  la limite du LCD
-    mem=i;//mmoire de la variable i
-    
-    
-    while(j <= y && j<NB_LIGNE)
-    {
-        i=mem;//on remet i  sa valeur initiale
-        while(i<=x && i<NB_COL) //on fait le 3x3 autour de la case voulue
-        { 
-            if(m_tabMines[j][i]!=MINE && m_tabVue[j][i]!=DRAPEAU) //si la case vrifie dans le 3x3 n'est ni une mine, ni un drapeau
-                m_tabVue[j][i]=m_tabMines[j][i]; //on la dvoile
-            i++;
-        }
-        j++;
-    }
-    afficheTabVue(); //on actualise le LCD avec la nouvelle matrice
-}
-
-/*
- * @brief Vrifie si gagn. On a gagn quand le nombre de tuiles non dvoiles
- * est gal au nombre de mines. On augmente de 1 le nombre de mines si on a 
- * gagn.
- * @param int* pMines. Le nombre de mine.
- * @return vrai si gagn, faux sinon
- */
-bool gagne(int* pMines) 
-{
-    char nbTuileEtDrapeau=0; //valeur de comparaison. doit tre gale  la somme du nombre de drapeaux et du nombre de tuiles dans m_tabVue
-    
-    for (char i = 0; i < NB_LIGNE; i++) {
-        for (char j = 0; j < NB_COL; j++) {//on parcourt le LCD au complet
-            if(m_tabVue[i][j]==TUILE||m_tabVue[i][j]==DRAPEAU) //si c'est un drapeau ou une tuile
-                nbTuileEtDrapeau++;//on incrmente
-        }
-    }
-    if (nbTuileEtDrapeau == *pMines)//si la valeur compte prcdemment correspond au nombre de mines
-    {
-        (*pMines)++; //on augmente le nombre de mines  placer pour la prochaine partie
-        return true;//retourne vrai (on a gagn)
-    }
-    else
-        return false;//retourne faux (on a pas gagn)
-}
-
-/*
- * @brief Lit le port analogique. 
- * @param Le no du port  lire
- * @return La valeur des 8 bits de poids forts du port analogique
- */
-char getAnalog(char canal) 
-{
-    ADCON0bits.CHS = canal;
-    __delay_us(1);
-    ADCON0bits.GO_DONE = 1; //lance une conversion
-    while (ADCON0bits.GO_DONE == 1); //attend fin de la conversion
-    return ADRESH; //retourne seulement les 8 MSB. On laisse tomber les 2 LSB de ADRESL
-}
-
-
-/*
- * @brief Affiche le tableau m_tabVue.
- * @param rien
- * @return rien
- */
-void afficheTabVue(void) 
-{
-    for (char i = 0; i < NB_LIGNE; i++) {//pour toutes les lignes  crire
-        lcd_gotoXY(1, i + 1);//on se dplace au dbut de la ligne  crire
-        lcd_putMessage(m_tabVue[i]);//on crit la ligne
-    }
-}
-
-/*
- * @brief Affiche le tableau m_tabMines.
- * @param rien
- * @return rien
- */
-void afficheTabMines(void) 
-{
-    for (char i = 0; i < NB_LIGNE; i++) {//pour toutes les lignes  crire
-        lcd_gotoXY(1, i + 1);//on se dplace au dbut de la ligne  crire
-        lcd_putMessage(m_tabMines[i]);//on crit la ligne
-    }
-}
-
-/*
- * @brief Remplace la tuile slectionne avec un drapeau dans m_tabVue. Si la case slectionne
- * est un drapeau, on l'enlve. Les drapeaux ne sont pas enlevs par enleveTuilesAutour.
- * On peut placer un drapeau seulement sur une tuile (pas une case vide ou chiffre).
- * @param char x, char y la position du curseur sur le LCD
- * @return rien
- */
-void metOuEnleveDrapeau(char x, char y) 
-{
-    if (m_tabVue[y-1][x-1]==TUILE)//si la case slectionne est une tuile
-        m_tabVue[y-1][x-1]=DRAPEAU;//on la remplace par un drapeau
-    else if (m_tabVue[y-1][x-1]==DRAPEAU)//sinon, si c'est un drapeau
-        m_tabVue[y-1][x-1]=TUILE;//on le remplace avec une tuile
-    afficheTabVue();//on actualise le LCD pour affiche la nouvelle matrice
-    while(SW0==0);//boucle antirebond qui attend que le bouton de la carte noire soit relch
-}
\ No newline at end of file
@@ -0,0 +1,130 @@
+/**
+ * @file   masque.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Conversions entre les tableaux du jeu et le champ compact.
+ *
+ * Les deux conversions parcourent les cases dans l'ordre du masque et
+ * avancent d'un octet du masque toutes les 8 cases, sans jamais recalculer
+ * l'indice k / 8 ni le dcalage k % 8.
+ */
+
+#include "masque.h"
+
+static unsigned int masque_crc16(unsigned int crc, const unsigned char* donnees, unsigned char taille);
+
+/*
+ * @brief Compacte un tableau du jeu. Voir masque.h.
+ * @param masque, tab, valeur Voir masque.h
+ * @return Le nombre de cases  1
+ */
+unsigned char masque_compacte(unsigned char* masque, char tab[NB_LIGNE][NB_COL + 1], char valeur)
+{
+    unsigned char bit = 1; //bit de la case courante dans l'octet courant
+    unsigned char nb = 0;
+
+    for (char i = 0; i < NB_LIGNE; i++) {
+        for (char j = 0; j < NB_COL; j++) {
+            if (bit == 1) //premire case d'un octet
+                *masque = 0;
+            if (tab[i][j] == valeur) {
+                *masque |= bit;
+                nb++;
+            }
+            bit <<= 1;
+            if (bit == 0) { //octet complet: on passe au suivant
+                bit = 1;
+                masque++;
+            }
+        }
+    }
+    return nb;
+}
+
+/*
+ * @brief Rempli m_tabMines  partir d'un masque. Voir masque.h.
+ * @param masque Le champ compact
+ * @return Le nombre de mines
+ */
+unsigned char masque_decompacte(const unsigned char* masque)
+{
+    unsigned char bit = 1;
+    unsigned char nb = 0;
+
+    for (char i = 0; i < NB_LIGNE; i++) {
+        for (char j = 0; j < NB_COL; j++) {
+            if (*masque & bit) {
+                m_tabMines[i][j] = MINE;
+                nb++;
+            } else
+                m_tabMines[i][j] = ' ';
+            bit <<= 1;
+            if (bit == 0) {
+                bit = 1;
+                masque++;
+            }
+        }
+    }
+    return nb;
+}
+
+/*
+ * @brief Calcule le CRC-8 d'une trame. Voir masque.h.
+ * @param donnees, taille Les octets  vrifier
+ * @return le CRC-8
+ */
+unsigned char masque_crc8(const unsigned char* donnees, unsigned char taille)
+{
+    unsigned char crc = 0;
+
+    for (unsigned char i = 0; i < taille; i++) {
+        crc ^= donnees[i];
+        for (char b = 0; b < 8; b++)
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+    return crc;
+}
+
+/*
+ * @brief Hachage de m_tabMines. Voir masque.h.
+ * @param rien
+ * @return le hachage sur 16 bits
+ */
+unsigned int masque_hacheChamp(void)
+{
+    unsigned char masque[NB_OCTETS_MASQUE];
+
+    masque_compacte(masque, m_tabMines, MINE);
+    return masque_crc16(0xFFFF, masque, NB_OCTETS_MASQUE);
+}
+
+/*
+ * @brief Hachage de m_tabVue. Voir masque.h.
+ * @param rien
+ * @return le hachage sur 16 bits
+ */
+unsigned int masque_hacheVue(void)
+{
+    unsigned int crc = 0xFFFF;
+
+    for (char i = 0; i < NB_LIGNE; i++)
+        crc = masque_crc16(crc, (const unsigned char*) m_tabVue[i], NB_COL);
+    return crc;
+}
+
+/*
+ * @brief Continue un CRC-16 CCITT (polynme 0x1021). Le rsultat est
+ * masqu sur 16 bits: unsigned int en a 32 sur l'ordinateur.
+ * @param unsigned int crc La valeur prcdente (0xFFFF au dbut)
+ * @param donnees, taille Les octets suivants
+ * @return le CRC-16
+ */
+static unsigned int masque_crc16(unsigned int crc, const unsigned char* donnees, unsigned char taille)
+{
+    for (unsigned char i = 0; i < taille; i++) {
+        crc ^= (unsigned int) donnees[i] << 8;
+        for (char b = 0; b < 8; b++)
+            crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) & 0xFFFF : (crc << 1) & 0xFFFF;
+    }
+    return crc;
+}
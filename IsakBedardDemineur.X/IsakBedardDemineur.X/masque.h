@@ -0,0 +1,64 @@
+/**
+ * @file   masque.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Champ de mines compact: 1 bit par case.
+ *
+ * La case (ligne, colonne) est le bit (k % 8) de l'octet k / 8, o
+ * k = ligne * NB_COL + colonne. C'est le format des champs changs par le
+ * port srie (voir commande.h). Les conversions avec les tableaux du jeu se
+ * font une ligne  la fois, dans l'ordre du masque.
+ */
+
+#ifndef MASQUE_H
+#define	MASQUE_H
+
+#include "demineur.h"
+
+#define MASQUE_TESTE(masque, k) ((masque)[(k) >> 3] & (1 << ((k) & 7))) //non nul si la case k est  1
+#define MASQUE_MET(masque, k) ((masque)[(k) >> 3] |= 1 << ((k) & 7)) //met la case k  1
+
+/**
+ * @brief Compacte un tableau du jeu: le bit d'une case est  1 si la case
+ * contient la valeur demande.
+ * @param masque Reoit NB_OCTETS_MASQUE octets
+ * @param tab m_tabMines ou m_tabVue
+ * @param valeur La valeur des cases  mettre  1 (ex: MINE)
+ * @return Le nombre de cases  1
+ */
+unsigned char masque_compacte(unsigned char* masque, char tab[NB_LIGNE][NB_COL + 1], char valeur);
+
+/**
+ * @brief Rempli m_tabMines  partir d'un masque de mines: MINE pour un bit 
+ * 1, un espace pour un bit  0. Les chiffres restent  calculer avec
+ * metToucheCombien().
+ * @param masque NB_OCTETS_MASQUE octets
+ * @return Le nombre de mines
+ */
+unsigned char masque_decompacte(const unsigned char* masque);
+
+/**
+ * @brief Calcule le CRC-8 (polynme x^8 + x^2 + x + 1, valeur initiale 0)
+ * qui suit le masque dans la commande 'L' (voir commande.h).
+ * @param donnees, taille Les octets  vrifier
+ * @return le CRC-8
+ */
+unsigned char masque_crc8(const unsigned char* donnees, unsigned char taille);
+
+/**
+ * @brief Hachage du champ de m_tabMines: CRC-16 CCITT (polynme 0x1021,
+ * valeur initiale 0xFFFF) du champ compact. C'est le hachage de la
+ * rponse de 'L' (commande.h) et du rapport de rejeu (mesure.h).
+ * @return le hachage sur 16 bits
+ */
+unsigned int masque_hacheChamp(void);
+
+/**
+ * @brief Hachage de m_tabVue: CRC-16 CCITT des NB_COL octets de chaque
+ * ligne, ligne par ligne. Deux rejeux qui finissent avec le mme
+ * affichage ont le mme hachage (rapport de rejeu, mesure.h).
+ * @return le hachage sur 16 bits
+ */
+unsigned int masque_hacheVue(void);
+
+#endif	/* MASQUE_H */
@@ -0,0 +1,408 @@
+/**
+ * @file   mesure.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Mesures de performance avec le Timer1. Voir mesure.h.
+ *
+ * Une mesure est la diffrence entre deux lectures de veille_cycles()
+ * (Timer1 prolong  32 bits, 1 cycle d'instruction par coup).
+ * Les interruptions restent actives pendant les mesures: le min et le p50 sont
+ * les valeurs  comparer, le max peut inclure une rception srie.
+ */
+
+#include <xc.h>
+#include <conio.h>
+#include "Lcd4Lignes.h"
+#include "serie.h"
+#include "demineur.h"
+#include "veille.h"
+#include "solveur.h"
+#include "hasard.h"
+#include "masque.h"
+#include "mesure.h"
+
+#define NB_ESSAIS 15 //mesures par mtrique
+#define INDICE_P90 13 //rang du 90e centile dans les NB_ESSAIS mesures tries
+#define MINES_MESURE 9 //nombre de mines des champs mesurs (difficult de dpart)
+#define CYCLES_PAR_S 250000UL //Fosc/4 = 250 kHz
+
+#define NB_CLASSES_REJEU 13 //classes des ticks rejous: moins de 64 cycles, de 128, ..., de 131072 (0,5 s), et plus
+#define PREMIERE_BORNE_REJEU 64 //cycles; chaque borne vaut 2 fois la prcdente
+
+#define METRIQUE_GENERATION 0 //ordre des mtriques dans la rponse et dans la rfrence
+#define METRIQUE_DEVOILE 1
+#define METRIQUE_GAGNE 2
+#define METRIQUE_AFFICHAGE 3
+#define METRIQUE_CHIFFRE 4
+#define METRIQUE_ACCORD 5
+
+static const char* const m_noms[NB_METRIQUES] = {"generation", "devoile", "gagne", "affichage", "chiffre", "accord"};
+static unsigned long m_echantillons[NB_ESSAIS]; //mesures de la mtrique en cours
+static unsigned long m_debut; //veille_cycles() au dbut de la mesure en cours
+
+static unsigned long m_debutRejeu; //veille_cycles()  la rception de 'R'
+static unsigned int m_ecrituresRejeu; //m_nbEcrituresLcd  la rception de 'R'
+static bool m_tickRejeu; //vrai si un tick rejou est en cours (m_debut est valide)
+static unsigned long m_nbTicksRejeu;
+static unsigned long m_minRejeu, m_maxRejeu; //tick rejou le plus court et le plus long
+static unsigned int m_classesRejeu[NB_CLASSES_REJEU]; //histogramme des ticks rejous
+
+static unsigned long mesure_essai(char metrique, unsigned char essai);
+static unsigned long mesure_chiffre(char metrique);
+static void mesure_demarre(void);
+static unsigned long mesure_arrete(void);
+static void mesure_trie(void);
+static void mesure_envoieCentiles(const char* nom);
+static void mesure_envoieValeurs(const char* nom, unsigned long min, unsigned long p50,
+                                 unsigned long p90, unsigned long max);
+static unsigned long mesure_centileRejeu(unsigned char pourcentage);
+
+/*
+ * @brief Mesure chaque mtrique NB_ESSAIS fois et envoie les centiles.
+ * @param const unsigned long* reference p50 de rfrence, ou 0
+ * @param unsigned char seuil Hausse tolre en pourcentage
+ * @return vrai si aucune mtrique n'a rgress
+ */
+bool mesure_execute(const unsigned long* reference, unsigned char seuil)
+{
+    bool ok = true;
+    bool regression;
+    unsigned int nbEcritures; //octets crits au LCD par un affichage
+    uint8_t nbMines = m_partie.nbMines; //difficult du joueur, remise  la fin
+
+    serie_envoieTexte("{\"unite\":\"cycles\",\"essais\":");
+    serie_envoieNombre(NB_ESSAIS);
+    serie_envoieTexte(",\"mines\":");
+    serie_envoieNombre(MINES_MESURE);
+    for (char m = 0; m < NB_METRIQUES; m++) {
+        for (unsigned char i = 0; i < NB_ESSAIS; i++)
+            m_echantillons[i] = mesure_essai(m, i);
+        mesure_trie();
+        mesure_envoieCentiles(m_noms[m]);
+        if (reference != 0) {
+            regression = m_echantillons[NB_ESSAIS / 2] * 100 > reference[m] * (100 + seuil);
+            serie_envoieTexte(regression ? ",\"regression\":true" : ",\"regression\":false");
+            if (regression)
+                ok = false;
+        }
+        putch('}');
+    }
+
+    nbEcritures = m_nbEcrituresLcd;
+    afficheTabVue();
+    nbEcritures = m_nbEcrituresLcd - nbEcritures;
+    serie_envoieTexte(",\"lcd_octets\":");
+    serie_envoieNombre(nbEcritures);
+    if (reference != 0)
+        serie_envoieTexte(ok ? ",\"ok\":true" : ",\"ok\":false");
+    serie_envoieTexte("}\r\n");
+    m_partie.nbMines = nbMines;
+    return ok;
+}
+
+/*
+ * @brief Mesure NB_ESSAIS gnrations de champs sans devinette et envoie
+ * les centiles. Voir mesure.h.
+ * @param uint8_t nbMines Le nombre de mines des champs
+ * @return rien
+ */
+void mesure_generation(uint8_t nbMines)
+{
+    unsigned long total = 0; //cycles de toutes les gnrations
+    unsigned char nbGarantis = 0;
+    unsigned int nbValidations = 0;
+    uint8_t x, y;
+
+    for (unsigned char i = 0; i < NB_ESSAIS; i++) {
+        hasard_germe(i + 1);
+        mesure_demarre();
+        if (solveur_genere(nbMines, &x, &y))
+            nbGarantis++;
+        m_echantillons[i] = mesure_arrete();
+        total += m_echantillons[i];
+        nbValidations += m_nbValidations;
+    }
+    mesure_trie();
+    serie_envoieTexte("{\"unite\":\"cycles\",\"essais\":");
+    serie_envoieNombre(NB_ESSAIS);
+    serie_envoieTexte(",\"mines\":");
+    serie_envoieNombre(nbMines);
+    mesure_envoieCentiles("sans_devinette");
+    serie_envoieTexte("},\"garantis\":");
+    serie_envoieNombre(nbGarantis);
+    serie_envoieTexte(",\"validations\":");
+    serie_envoieNombre(nbValidations);
+    serie_envoieTexte(",\"champs_par_min\":");
+    serie_envoieNombre(NB_ESSAIS * 60 * CYCLES_PAR_S / total);
+    serie_envoieTexte("}\r\n");
+}
+
+/*
+ * @brief Gnre le champ de l'essai et mesure une mtrique. Les tapes qui
+ * prcdent la mtrique sont refaites sans tre mesures, pour que chaque
+ * mtrique parte du mme tat.
+ * @param char metrique METRIQUE_xxx
+ * @param unsigned char essai Numro de l'essai, sert de germe  hasard()
+ * @return la dure en cycles
+ */
+static unsigned long mesure_essai(char metrique, unsigned char essai)
+{
+    unsigned long duree;
+    uint8_t x = 1, y = 1;
+
+    hasard_germe(essai + 1); //mme champ pour chaque mtrique d'un mme essai
+    mesure_demarre();
+    rempliMines(MINES_MESURE);
+    metToucheCombien();
+    duree = mesure_arrete();
+    if (metrique == METRIQUE_GENERATION)
+        return duree;
+    if (metrique == METRIQUE_CHIFFRE || metrique == METRIQUE_ACCORD)
+        return mesure_chiffre(metrique);
+
+    initTabVue();
+    while (y <= NB_LIGNE && m_tabMines[y - 1][x - 1] != ' ') { //premire case vide: dvoile aussi ses voisines
+        x++;
+        if (x > NB_COL) {
+            x = 1;
+            y++;
+        }
+    }
+    if (y > NB_LIGNE) //aucune case vide: on mesure quand mme une case
+        y = 1;
+    mesure_demarre();
+    demine(x, y);
+    duree = mesure_arrete();
+    if (metrique == METRIQUE_DEVOILE)
+        return duree;
+
+    m_partie.nbMines = MINES_MESURE; //gagne() compare avec m_partie et l'augmente si le champ est gagn
+    mesure_demarre();
+    gagne();
+    duree = mesure_arrete();
+    if (metrique == METRIQUE_GAGNE)
+        return duree;
+
+    mesure_demarre();
+    afficheTabVue();
+    return mesure_arrete();
+}
+
+/*
+ * @brief Mesure le dvoilement d'un chiffre, puis l'accord sur ce chiffre:
+ * un drapeau est mis sur chaque mine voisine, et demine() sur le chiffre
+ * dvoil dvoile ses voisines et ouvre les zones vides (devoileAutour()).
+ * @param char metrique METRIQUE_CHIFFRE ou METRIQUE_ACCORD
+ * @return la dure en cycles
+ */
+static unsigned long mesure_chiffre(char metrique)
+{
+    unsigned long duree;
+    uint8_t x = 1, y = 1;
+
+    initTabVue();
+    while (y <= NB_LIGNE && (m_tabMines[y - 1][x - 1] == ' ' || m_tabMines[y - 1][x - 1] == MINE)) { //premier chiffre
+        x++;
+        if (x > NB_COL) {
+            x = 1;
+            y++;
+        }
+    }
+    if (y > NB_LIGNE) //aucun chiffre: impossible avec MINES_MESURE mines, on mesure quand mme une case
+        y = 1;
+    mesure_demarre();
+    demine(x, y);
+    duree = mesure_arrete();
+    if (metrique == METRIQUE_CHIFFRE)
+        return duree;
+
+    for (char j = VOISIN_MIN(y - 1); j <= VOISIN_MAX(y - 1, NB_LIGNE); j++)
+        for (char i = VOISIN_MIN(x - 1); i <= VOISIN_MAX(x - 1, NB_COL); i++)
+            if (m_tabMines[j][i] == MINE)
+                m_tabVue[j][i] = DRAPEAU; //les drapeaux du joueur, tous bien placs
+    mesure_demarre();
+    demine(x, y);
+    return mesure_arrete();
+}
+
+/*
+ * @brief Commence le rapport d'un rejeu. Voir mesure.h.
+ * @param rien
+ * @return rien
+ */
+void mesure_debutRejeu(void)
+{
+    m_debutRejeu = veille_cycles();
+    m_ecrituresRejeu = m_nbEcrituresLcd;
+    m_tickRejeu = false;
+    m_nbTicksRejeu = 0;
+    m_minRejeu = 0xFFFFFFFF;
+    m_maxRejeu = 0;
+    for (char c = 0; c < NB_CLASSES_REJEU; c++)
+        m_classesRejeu[c] = 0;
+}
+
+/*
+ * @brief Note le dbut du travail d'un tick rejou, une fois ses entres
+ * reues de l'hte.
+ * @param rien
+ * @return rien
+ */
+void mesure_debutTickRejeu(void)
+{
+    mesure_demarre();
+    m_tickRejeu = true;
+}
+
+/*
+ * @brief Compte le travail du tick rejou en cours, avant de demander les
+ * entres du suivant: l'attente de l'hte n'est pas compte.
+ * @param rien
+ * @return rien
+ */
+void mesure_finTickRejeu(void)
+{
+    unsigned long duree;
+    unsigned long borne = PREMIERE_BORNE_REJEU;
+    unsigned char classe = 0;
+
+    if (!m_tickRejeu)
+        return;
+    duree = mesure_arrete();
+    m_tickRejeu = false;
+    m_nbTicksRejeu++;
+    if (duree < m_minRejeu)
+        m_minRejeu = duree;
+    if (duree > m_maxRejeu)
+        m_maxRejeu = duree;
+    while (classe < NB_CLASSES_REJEU - 1 && duree >= borne) {
+        classe++;
+        borne <<= 1;
+    }
+    if (m_classesRejeu[classe] != 0xFFFF) //le compteur s'arrte  65535
+        m_classesRejeu[classe]++;
+}
+
+/*
+ * @brief Envoie le rapport de fin de rejeu. Voir mesure.h.
+ * @param rien
+ * @return rien
+ */
+void mesure_finRejeu(void)
+{
+    unsigned long duree = veille_cycles() - m_debutRejeu;
+
+    serie_envoieTexte("{\"rejeu\":\"fin\",\"unite\":\"cycles\",\"ticks\":");
+    serie_envoieNombre(m_nbTicksRejeu);
+    serie_envoieTexte(",\"cycles\":");
+    serie_envoieNombre(duree);
+    if (m_nbTicksRejeu == 0)
+        m_minRejeu = 0;
+    mesure_envoieValeurs("par_tick", m_minRejeu, mesure_centileRejeu(50), mesure_centileRejeu(90), m_maxRejeu);
+    serie_envoieTexte("},\"lcd_octets\":");
+    serie_envoieNombre(m_nbEcrituresLcd - m_ecrituresRejeu);
+    serie_envoieTexte(",\"etat\":{\"x\":");
+    serie_envoieNombre(m_partie.x);
+    serie_envoieTexte(",\"y\":");
+    serie_envoieNombre(m_partie.y);
+    serie_envoieTexte(",\"mines\":");
+    serie_envoieNombre(m_partie.nbMines);
+    serie_envoieTexte(",\"champ\":");
+    serie_envoieNombre(masque_hacheChamp());
+    serie_envoieTexte(",\"vue\":");
+    serie_envoieNombre(masque_hacheVue());
+    serie_envoieTexte("}}\r\n");
+}
+
+/*
+ * @brief Donne un centile des ticks rejous  partir de l'histogramme: la
+ * borne haute de la classe qui le contient, au plus le tick le plus long.
+ * @param unsigned char pourcentage 50 ou 90
+ * @return le centile en cycles,  un facteur 2 prs
+ */
+static unsigned long mesure_centileRejeu(unsigned char pourcentage)
+{
+    unsigned long rang = (m_nbTicksRejeu * pourcentage + 99) / 100; //nombre de ticks au plus gaux au centile
+    unsigned long cumul = 0;
+    unsigned long borne = PREMIERE_BORNE_REJEU;
+
+    for (char c = 0; c < NB_CLASSES_REJEU - 1; c++) {
+        cumul += m_classesRejeu[c];
+        if (cumul >= rang)
+            return (borne < m_maxRejeu) ? borne : m_maxRejeu;
+        borne <<= 1;
+    }
+    return m_maxRejeu;
+}
+
+/*
+ * @brief Note le dbut d'une mesure.
+ * @param rien
+ * @return rien
+ */
+static void mesure_demarre(void)
+{
+    m_debut = veille_cycles();
+}
+
+/*
+ * @brief Termine la mesure en cours.
+ * @param rien
+ * @return le nombre de cycles depuis mesure_demarre()
+ */
+static unsigned long mesure_arrete(void)
+{
+    return veille_cycles() - m_debut;
+}
+
+/*
+ * @brief Envoie les centiles des mesures tries, sans fermer l'objet:
+ * ,"nom":{"min":..,"p50":..,"p90":..,"max":..
+ * @param const char* nom Le nom de la mtrique
+ * @return rien
+ */
+static void mesure_envoieCentiles(const char* nom)
+{
+    mesure_envoieValeurs(nom, m_echantillons[0], m_echantillons[NB_ESSAIS / 2],
+                         m_echantillons[INDICE_P90], m_echantillons[NB_ESSAIS - 1]);
+}
+
+/*
+ * @brief Envoie quatre centiles, sans fermer l'objet (voir
+ * mesure_envoieCentiles()).
+ * @param const char* nom Le nom de la mtrique
+ * @param unsigned long min, p50, p90, max Les valeurs
+ * @return rien
+ */
+static void mesure_envoieValeurs(const char* nom, unsigned long min, unsigned long p50,
+                                 unsigned long p90, unsigned long max)
+{
+    serie_envoieTexte(",\"");
+    serie_envoieTexte(nom);
+    serie_envoieTexte("\":{\"min\":");
+    serie_envoieNombre(min);
+    serie_envoieTexte(",\"p50\":");
+    serie_envoieNombre(p50);
+    serie_envoieTexte(",\"p90\":");
+    serie_envoieNombre(p90);
+    serie_envoieTexte(",\"max\":");
+    serie_envoieNombre(max);
+}
+
+/*
+ * @brief Trie les mesures en ordre croissant (insertion, 15 valeurs).
+ * @param rien
+ * @return rien
+ */
+static void mesure_trie(void)
+{
+    unsigned long valeur;
+    signed char j;
+
+    for (char i = 1; i < NB_ESSAIS; i++) {
+        valeur = m_echantillons[i];
+        for (j = i - 1; j >= 0 && m_echantillons[j] > valeur; j--)
+            m_echantillons[j + 1] = m_echantillons[j];
+        m_echantillons[j + 1] = valeur;
+    }
+}
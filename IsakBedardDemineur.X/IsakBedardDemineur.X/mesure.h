@@ -0,0 +1,107 @@
+/**
+ * @file   mesure.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Mesures de performance du jeu sur la carte, envoyes en JSON par
+ * le port srie.
+ *
+ * Chaque mtrique est mesure NB_ESSAIS fois avec le Timer1, en cycles
+ * d'instruction (Fosc/4, 4 us par cycle). Les champs sont gnrs  partir
+ * de germes fixes: deux mesures du mme programme jouent les mmes champs.
+ * Mtriques:
+ *  - "generation": rempliMines() + metToucheCombien();
+ *  - "devoile": demine() sur la premire case vide du champ;
+ *  - "gagne": gagne() sur le champ qui vient d'tre dvoil;
+ *  - "affichage": afficheTabVue();
+ *  - "chiffre": demine() sur le premier chiffre du champ (une seule case);
+ *  - "accord": demine() sur ce chiffre une fois dvoil, avec un drapeau sur
+ *    chaque mine voisine: dvoile les voisines et ouvre les zones vides.
+ * Rponse (une ligne):
+ *  {"unite":"cycles","essais":15,"mines":9,
+ *   "generation":{"min":..,"p50":..,"p90":..,"max":..}, ... ,
+ *   "lcd_octets":84}
+ * o lcd_octets est le nombre d'octets crits au LCD par un affichage.
+ *
+ * En mode comparaison, l'hte envoie la rfrence (p50 de chaque mtrique,
+ * enregistre lors d'une mesure prcdente) et un seuil en pourcentage.
+ * Chaque mtrique reoit alors "regression":true si son p50 dpasse la
+ * rfrence de plus du seuil, et la rponse se termine par "ok":false si
+ * au moins une mtrique a rgress. hote/perf -p crit cette commande 
+ * partir d'une rponse prcdente, et hote/perf -d retourne 1 sur une
+ * rponse qui finit par "ok":false. Sur l'ordinateur, hote/perf mesure les
+ * mmes mtriques et une partie rejoue, contre une rfrence enregistre.
+ *
+ * La commande 'G' mesure  part la gnration des champs sans devinette
+ * (solveur_genere(), voir solveur.h), qui dpend beaucoup du nombre de mines:
+ *  {"unite":"cycles","essais":15,"mines":..,
+ *   "sans_devinette":{"min":..,"p50":..,"p90":..,"max":..},
+ *   "garantis":..,"validations":..,"champs_par_min":..}
+ * o garantis est le nombre de champs valids par le solveur, validations le
+ * nombre total de passages du solveur et champs_par_min le dbit moyen.
+ *
+ * Un rejeu (commande 'R', voir entrees.h) mesure une partie enregistre au
+ * complet.  la fin du rejeu, l'appareil envoie:
+ *  {"rejeu":"fin","unite":"cycles","ticks":..,"cycles":..,
+ *   "par_tick":{"min":..,"p50":..,"p90":..,"max":..},"lcd_octets":..,
+ *   "etat":{"x":..,"y":..,"mines":..,"champ":..,"vue":..}}
+ * o cycles est le temps depuis la rception de 'R' (nouvelle partie et
+ * attente de l'hte comprises), par_tick le travail de chaque tick rejou
+ * (sans l'attente de l'hte) et lcd_octets le nombre d'octets crits au LCD
+ * depuis 'R' (le LCD est rinitialis  'R': le contenu de la CGRAM avant
+ * le rejeu ne change pas ce nombre). etat est l'tat final de la partie:
+ * curseur, nombre de mines, hachages de m_tabMines et de m_tabVue
+ * (masque.h). hote/rejeu rejoue le mme enregistrement sur l'ordinateur
+ * et donne les mmes ticks, lcd_octets et etat. Le p50 et le p90 viennent d'un histogramme dont chaque classe
+ * double la prcdente: ils sont justes  un facteur 2 prs.
+ */
+
+#ifndef MESURE_H
+#define	MESURE_H
+
+#include <stdbool.h>  // pour l'utilisation du type bool
+#include <stdint.h>  // pour les types de taille fixe (uint8_t)
+
+#define NB_METRIQUES 6 //generation, devoile, gagne, affichage, chiffre, accord
+
+/**
+ * @brief Fait toutes les mesures et envoie le rsultat. Dtruit la partie en
+ * cours: l'appelant doit en commencer une nouvelle.
+ * @param reference p50 de rfrence de chaque mtrique, dans l'ordre de
+ * mesure.h, ou 0 pour mesurer sans comparer
+ * @param seuil Pourcentage de hausse tolr par rapport  la rfrence
+ * @return vrai si aucune mtrique n'a rgress
+ */
+bool mesure_execute(const unsigned long* reference, unsigned char seuil);
+
+/**
+ * @brief Mesure la gnration de NB_ESSAIS champs sans devinette et envoie
+ * le rsultat. Dtruit la partie en cours.
+ * @param nbMines Le nombre de mines des champs, 1  NB_CASES - 1
+ */
+void mesure_generation(uint8_t nbMines);
+
+/**
+ * @brief Commence le rapport d'un rejeu. Appele  la rception de 'R',
+ * avant la nouvelle partie.
+ */
+void mesure_debutRejeu(void);
+
+/**
+ * @brief Note le dbut d'un tick rejou. Appele par entrees_lit() une fois
+ * les entres du tick reues.
+ */
+void mesure_debutTickRejeu(void);
+
+/**
+ * @brief Compte le tick rejou en cours. Appele par entrees_lit() avant de
+ * demander les entres du tick suivant.
+ */
+void mesure_finTickRejeu(void);
+
+/**
+ * @brief Envoie le rapport du rejeu (format ci-dessus). Appele par
+ * entrees_lit() quand l'hte termine le rejeu.
+ */
+void mesure_finRejeu(void);
+
+#endif	/* MESURE_H */
@@ -0,0 +1,219 @@
+/**
+ * @file   moniteur.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Dpassements d'chance par tick et histogramme des carts entre
+ * les ticks. Voir moniteur.h.
+ *
+ * Tout est horodat avec veille_cycles(). Les compteurs occupent une taille
+ * fixe en RAM: NB_DERNIERS dpassements gards en rond, un compteur par tche
+ * et un par classe d'cart (les compteurs de 16 bits s'arrtent  65535).
+ */
+
+#include <xc.h>
+#include <conio.h>
+#include <stdbool.h>  // pour l'utilisation du type bool
+#include "serie.h"
+#include "entrees.h"
+#include "veille.h"
+#include "moniteur.h"
+
+#define CYCLES_PAR_MS 250UL //Fosc/4 = 250 kHz
+#define CYCLES_PAR_TICK (100 * CYCLES_PAR_MS) //tick de 100 ms
+#define ECHEANCE_DEFAUT 100 //ms: tout le tick
+#define NB_DERNIERS 8 //dpassements gards
+#define NB_CLASSES 6 //classes de l'histogramme des carts
+#define PREMIERE_BORNE 64 //cycles; chaque borne vaut 4 fois la prcdente
+
+typedef struct {
+    unsigned long noTick; //m_noTick du tick en retard
+    unsigned long duree; //travail du tick, en cycles
+    unsigned char tache; //tche la plus longue du tick
+} Depassement;
+
+static const char* const m_nomsTaches[NB_TACHES] = {"entrees", "deplace", "joue", "drapeau", "affichage", "partie", "commande"};
+
+static unsigned long m_echeance = ECHEANCE_DEFAUT * CYCLES_PAR_MS; //travail permis par tick, en cycles
+static bool m_actif = false; //vrai si un tick a commenc (m_debutTick est valide)
+static unsigned long m_debutTick; //rveil du tick en cours
+static unsigned long m_debutTache; //dbut de la tche en cours
+static unsigned char m_tache; //tche en cours
+static unsigned long m_dureeTaches[NB_TACHES]; //temps de chaque tche dans le tick en cours
+
+static unsigned long m_nbTicks = 0; //ticks surveills
+static unsigned int m_nbDepassements = 0;
+static unsigned int m_depassementsTache[NB_TACHES]; //dpassements attribus  chaque tche
+static Depassement m_derniers[NB_DERNIERS]; //derniers dpassements, en rond
+static unsigned char m_prochain = 0; //case du prochain dpassement dans m_derniers
+static unsigned int m_ecarts[NB_CLASSES]; //histogramme des carts entre deux rveils
+
+static void moniteur_compte(unsigned int* compteur);
+
+/*
+ * @brief Note le rveil et classe l'cart avec le rveil prcdent.
+ * @param rien
+ * @return rien
+ */
+void moniteur_debutTick(void)
+{
+    unsigned long maintenant = veille_cycles();
+    unsigned long ecart;
+    unsigned long borne = PREMIERE_BORNE;
+    unsigned char classe = 0;
+
+    if (m_actif) {
+        ecart = maintenant - m_debutTick;
+        ecart = (ecart > CYCLES_PAR_TICK) ? ecart - CYCLES_PAR_TICK : CYCLES_PAR_TICK - ecart;
+        while (classe < NB_CLASSES - 1 && ecart >= borne) {
+            classe++;
+            borne <<= 2;
+        }
+        moniteur_compte(&m_ecarts[classe]);
+    }
+    m_actif = true;
+    m_debutTick = maintenant;
+    m_debutTache = maintenant;
+    m_tache = TACHE_ENTREES;
+    for (char t = 0; t < NB_TACHES; t++)
+        m_dureeTaches[t] = 0;
+    m_nbTicks++;
+}
+
+/*
+ * @brief Termine le tick et note un dpassement s'il y a lieu.
+ * @param rien
+ * @return rien
+ */
+void moniteur_finTick(void)
+{
+    unsigned long duree;
+    unsigned char pire = 0; //tche la plus longue du tick
+
+    if (!m_actif)
+        return;
+    moniteur_tache(TACHE_ENTREES); //termine la tche en cours
+    duree = m_debutTache - m_debutTick;
+    if (duree <= m_echeance)
+        return;
+
+    for (char t = 1; t < NB_TACHES; t++)
+        if (m_dureeTaches[t] > m_dureeTaches[pire])
+            pire = t;
+    m_derniers[m_prochain].noTick = m_noTick - 1; //entrees_lit() a dj compt ce tick
+    m_derniers[m_prochain].duree = duree;
+    m_derniers[m_prochain].tache = pire;
+    m_prochain = (m_prochain + 1) % NB_DERNIERS;
+    moniteur_compte(&m_nbDepassements);
+    moniteur_compte(&m_depassementsTache[pire]);
+}
+
+/*
+ * @brief Compte le temps de la tche en cours et passe  la suivante.
+ * @param unsigned char tache TACHE_xxx
+ * @return rien
+ */
+void moniteur_tache(unsigned char tache)
+{
+    unsigned long maintenant;
+
+    if (!m_actif) //rejeu en cours: les ticks ne sont pas surveills
+        return;
+    maintenant = veille_cycles();
+    m_dureeTaches[m_tache] += maintenant - m_debutTache;
+    m_debutTache = maintenant;
+    m_tache = tache;
+}
+
+/*
+ * @brief Oublie le tick en cours. Voir moniteur.h.
+ * @param rien
+ * @return rien
+ */
+void moniteur_suspend(void)
+{
+    m_actif = false;
+    for (char t = 0; t < NB_TACHES; t++)
+        m_dureeTaches[t] = 0;
+}
+
+/*
+ * @brief Change l'chance et remet les compteurs  zro.
+ * @param unsigned char ms L'chance en millisecondes
+ * @return rien
+ */
+void moniteur_echeance(unsigned char ms)
+{
+    m_echeance = ms * CYCLES_PAR_MS;
+    m_actif = false; //le prochain rveil ne compte pas d'cart
+    m_nbTicks = 0;
+    m_nbDepassements = 0;
+    m_prochain = 0;
+    for (char t = 0; t < NB_TACHES; t++)
+        m_depassementsTache[t] = 0;
+    for (char i = 0; i < NB_DERNIERS; i++)
+        m_derniers[i].duree = 0; //case vide
+    for (char c = 0; c < NB_CLASSES; c++)
+        m_ecarts[c] = 0;
+}
+
+/*
+ * @brief Envoie les compteurs en JSON. Voir moniteur.h.
+ * @param rien
+ * @return rien
+ */
+void moniteur_envoie(void)
+{
+    unsigned char i = m_prochain; //le plus ancien dpassement gard
+    bool premier = true;
+
+    serie_envoieTexte("{\"echeance\":");
+    serie_envoieNombre(m_echeance);
+    serie_envoieTexte(",\"ticks\":");
+    serie_envoieNombre(m_nbTicks);
+    serie_envoieTexte(",\"depassements\":");
+    serie_envoieNombre(m_nbDepassements);
+    serie_envoieTexte(",\"par_tache\":{");
+    for (char t = 0; t < NB_TACHES; t++) {
+        if (t != 0)
+            putch(',');
+        putch('"');
+        serie_envoieTexte(m_nomsTaches[t]);
+        serie_envoieTexte("\":");
+        serie_envoieNombre(m_depassementsTache[t]);
+    }
+    serie_envoieTexte("},\"derniers\":[");
+    do {
+        if (m_derniers[i].duree != 0) {
+            if (!premier)
+                putch(',');
+            premier = false;
+            serie_envoieTexte("{\"tick\":");
+            serie_envoieNombre(m_derniers[i].noTick);
+            serie_envoieTexte(",\"cycles\":");
+            serie_envoieNombre(m_derniers[i].duree);
+            serie_envoieTexte(",\"tache\":\"");
+            serie_envoieTexte(m_nomsTaches[m_derniers[i].tache]);
+            putch('"');
+            putch('}');
+        }
+        i = (i + 1) % NB_DERNIERS;
+    } while (i != m_prochain);
+    serie_envoieTexte("],\"ecarts\":[");
+    for (char c = 0; c < NB_CLASSES; c++) {
+        if (c != 0)
+            putch(',');
+        serie_envoieNombre(m_ecarts[c]);
+    }
+    serie_envoieTexte("]}\r\n");
+}
+
+/*
+ * @brief Augmente un compteur de 16 bits sans le faire dborder.
+ * @param unsigned int* compteur Le compteur
+ * @return rien
+ */
+static void moniteur_compte(unsigned int* compteur)
+{
+    if (*compteur != 0xFFFF)
+        (*compteur)++;
+}
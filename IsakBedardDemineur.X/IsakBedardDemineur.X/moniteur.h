@@ -0,0 +1,85 @@
+/**
+ * @file   moniteur.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Surveillance de l'chance de chaque tick et de la rgularit des
+ * ticks.
+ *
+ * Le travail d'un tick va du rveil (fin de veille_attendTick()) jusqu'au
+ * retour en veille. La boucle principale indique avec moniteur_tache() quelle
+ * tche commence: le temps de chaque tche est compt pendant le tick. Si le
+ * tick dpasse l'chance, le dpassement est not avec le numro du tick et
+ * la tche qui a pris le plus de temps. Les numros de tick sont ceux de
+ * m_noTick, comme dans les enregistrements d'entres (entrees.h): on
+ * retrouve dans l'enregistrement le tick  rejouer pour reproduire un
+ * dpassement.
+ *
+ * L'cart entre deux rveils et les 100 ms prvues est class dans un
+ * histogramme: moins de 64 cycles (0,25 ms), de 256, de 1024, de 4096, de
+ * 16384 (65 ms), et plus.
+ *
+ * Le moniteur ne fonctionne qu'en temps rel: rien n'est compt pendant un
+ * rejeu, o les ticks s'enchanent sans attendre. Le tick en cours est
+ * oubli au dbut et  la fin du rejeu (moniteur_suspend()): le premier
+ * tick aprs le rejeu ne compte ni dpassement ni cart. Pour retrouver ce
+ * qu'a fait un tick en retard, hote/rejeu -t le rejoue sur l'ordinateur.
+ *
+ * Rponse de la commande 'J' (une ligne JSON, dures en cycles de 4 us):
+ *  {"echeance":..,"ticks":..,"depassements":..,
+ *   "par_tache":{"entrees":..,"deplace":..,...},
+ *   "derniers":[{"tick":..,"cycles":..,"tache":".."},...],
+ *   "ecarts":[..,..,..,..,..,..]}
+ * o "derniers" contient les NB_DERNIERS derniers dpassements, du plus
+ * ancien au plus rcent.
+ */
+
+#ifndef MONITEUR_H
+#define	MONITEUR_H
+
+#define TACHE_ENTREES 0 //lecture des entres, au dbut de chaque tick
+#define TACHE_DEPLACE 1 //dplacement du curseur
+#define TACHE_JOUE 2 //dvoilement d'une case
+#define TACHE_DRAPEAU 3 //drapeau
+#define TACHE_AFFICHAGE 4 //criture du LCD
+#define TACHE_PARTIE 5 //nouvelle partie (gnration et affichage)
+#define TACHE_COMMANDE 6 //commande reue par le port srie
+#define NB_TACHES 7
+
+/**
+ * @brief Note le rveil au dbut d'un tick. Appele par entrees_lit().
+ */
+void moniteur_debutTick(void);
+
+/**
+ * @brief Note la fin du travail du tick et vrifie l'chance. Appele par
+ * entrees_lit() avant la mise en veille.
+ */
+void moniteur_finTick(void);
+
+/**
+ * @brief Oublie le tick en cours sans le compter. Le temps des tches n'est
+ * plus compt jusqu'au prochain moniteur_debutTick(), qui ne classe pas
+ * d'cart. Appele par entrees_rejoue() et  la fin d'un rejeu.
+ */
+void moniteur_suspend(void);
+
+/**
+ * @brief Indique que la tche donne commence. Le temps coul depuis
+ * l'appel prcdent est compt  la tche prcdente. Ne fait rien hors
+ * d'un tick surveill.
+ * @param tache TACHE_xxx
+ */
+void moniteur_tache(unsigned char tache);
+
+/**
+ * @brief Change l'chance et remet tous les compteurs  zro.
+ * @param ms La nouvelle chance en millisecondes (1  255)
+ */
+void moniteur_echeance(unsigned char ms);
+
+/**
+ * @brief Envoie les compteurs sur le port srie (format ci-dessus).
+ */
+void moniteur_envoie(void);
+
+#endif	/* MONITEUR_H */
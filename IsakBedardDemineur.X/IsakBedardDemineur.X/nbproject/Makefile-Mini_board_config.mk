@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=main.c Lcd4Lignes.c serie.c
+SOURCEFILES_QUOTED_IF_SPACED=main.c Lcd4Lignes.c serie.c solveur.c commande.c entrees.c stats.c masque.c mesure.c veille.c moniteur.c regles.c hasard.c partie.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/main.p1 ${OBJECTDIR}/Lcd4Lignes.p1 ${OBJECTDIR}/serie.p1
-POSSIBLE_DEPFILES=${OBJECTDIR}/main.p1.d ${OBJECTDIR}/Lcd4Lignes.p1.d ${OBJECTDIR}/serie.p1.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/main.p1 ${OBJECTDIR}/Lcd4Lignes.p1 ${OBJECTDIR}/serie.p1 ${OBJECTDIR}/solveur.p1 ${OBJECTDIR}/commande.p1 ${OBJECTDIR}/entrees.p1 ${OBJECTDIR}/stats.p1 ${OBJECTDIR}/masque.p1 ${OBJECTDIR}/mesure.p1 ${OBJECTDIR}/veille.p1 ${OBJECTDIR}/moniteur.p1 ${OBJECTDIR}/regles.p1 ${OBJECTDIR}/hasard.p1 ${OBJECTDIR}/partie.p1
+POSSIBLE_DEPFILES=${OBJECTDIR}/main.p1.d ${OBJECTDIR}/Lcd4Lignes.p1.d ${OBJECTDIR}/serie.p1.d ${OBJECTDIR}/solveur.p1.d ${OBJECTDIR}/commande.p1.d ${OBJECTDIR}/entrees.p1.d ${OBJECTDIR}/stats.p1.d ${OBJECTDIR}/masque.p1.d ${OBJECTDIR}/mesure.p1.d ${OBJECTDIR}/veille.p1.d ${OBJECTDIR}/moniteur.p1.d ${OBJECTDIR}/regles.p1.d ${OBJECTDIR}/hasard.p1.d ${OBJECTDIR}/partie.p1.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/main.p1 ${OBJECTDIR}/Lcd4Lignes.p1 ${OBJECTDIR}/serie.p1
+OBJECTFILES=${OBJECTDIR}/main.p1 ${OBJECTDIR}/Lcd4Lignes.p1 ${OBJECTDIR}/serie.p1 ${OBJECTDIR}/solveur.p1 ${OBJECTDIR}/commande.p1 ${OBJECTDIR}/entrees.p1 ${OBJECTDIR}/stats.p1 ${OBJECTDIR}/masque.p1 ${OBJECTDIR}/mesure.p1 ${OBJECTDIR}/veille.p1 ${OBJECTDIR}/moniteur.p1 ${OBJECTDIR}/regles.p1 ${OBJECTDIR}/hasard.p1 ${OBJECTDIR}/partie.p1
 
 # Source Files
-SOURCEFILES=main.c Lcd4Lignes.c serie.c
+SOURCEFILES=main.c Lcd4Lignes.c serie.c solveur.c commande.c entrees.c stats.c masque.c mesure.c veille.c moniteur.c regles.c hasard.c partie.c
 
 
 
@@ -118,6 +118,94 @@ ${OBJECTDIR}/serie.p1: serie.c  nbproject/Makefile-${CND_CONF}.mk
 	@-${MV} ${OBJECTDIR}/serie.d ${OBJECTDIR}/serie.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/serie.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/partie.p1: partie.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/partie.p1.d 
+	@${RM} ${OBJECTDIR}/partie.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/partie.p1 partie.c 
+	@-${MV} ${OBJECTDIR}/partie.d ${OBJECTDIR}/partie.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/partie.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/hasard.p1: hasard.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/hasard.p1.d 
+	@${RM} ${OBJECTDIR}/hasard.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/hasard.p1 hasard.c 
+	@-${MV} ${OBJECTDIR}/hasard.d ${OBJECTDIR}/hasard.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/hasard.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/regles.p1: regles.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/regles.p1.d 
+	@${RM} ${OBJECTDIR}/regles.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/regles.p1 regles.c 
+	@-${MV} ${OBJECTDIR}/regles.d ${OBJECTDIR}/regles.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/regles.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/moniteur.p1: moniteur.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/moniteur.p1.d 
+	@${RM} ${OBJECTDIR}/moniteur.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/moniteur.p1 moniteur.c 
+	@-${MV} ${OBJECTDIR}/moniteur.d ${OBJECTDIR}/moniteur.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/moniteur.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/veille.p1: veille.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/veille.p1.d 
+	@${RM} ${OBJECTDIR}/veille.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/veille.p1 veille.c 
+	@-${MV} ${OBJECTDIR}/veille.d ${OBJECTDIR}/veille.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/veille.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/mesure.p1: mesure.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/mesure.p1.d 
+	@${RM} ${OBJECTDIR}/mesure.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/mesure.p1 mesure.c 
+	@-${MV} ${OBJECTDIR}/mesure.d ${OBJECTDIR}/mesure.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/mesure.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/masque.p1: masque.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/masque.p1.d 
+	@${RM} ${OBJECTDIR}/masque.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/masque.p1 masque.c 
+	@-${MV} ${OBJECTDIR}/masque.d ${OBJECTDIR}/masque.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/masque.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/stats.p1: stats.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/stats.p1.d 
+	@${RM} ${OBJECTDIR}/stats.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/stats.p1 stats.c 
+	@-${MV} ${OBJECTDIR}/stats.d ${OBJECTDIR}/stats.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/stats.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/entrees.p1: entrees.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/entrees.p1.d 
+	@${RM} ${OBJECTDIR}/entrees.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/entrees.p1 entrees.c 
+	@-${MV} ${OBJECTDIR}/entrees.d ${OBJECTDIR}/entrees.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/entrees.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/commande.p1: commande.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/commande.p1.d 
+	@${RM} ${OBJECTDIR}/commande.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/commande.p1 commande.c 
+	@-${MV} ${OBJECTDIR}/commande.d ${OBJECTDIR}/commande.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/commande.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/solveur.p1: solveur.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/solveur.p1.d 
+	@${RM} ${OBJECTDIR}/solveur.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/solveur.p1 solveur.c 
+	@-${MV} ${OBJECTDIR}/solveur.d ${OBJECTDIR}/solveur.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/solveur.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 else
 ${OBJECTDIR}/main.p1: main.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}" 
@@ -143,6 +231,94 @@ ${OBJECTDIR}/serie.p1: serie.c  nbproject/Makefile-${CND_CONF}.mk
 	@-${MV} ${OBJECTDIR}/serie.d ${OBJECTDIR}/serie.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/serie.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/partie.p1: partie.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/partie.p1.d 
+	@${RM} ${OBJECTDIR}/partie.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/partie.p1 partie.c 
+	@-${MV} ${OBJECTDIR}/partie.d ${OBJECTDIR}/partie.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/partie.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/hasard.p1: hasard.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/hasard.p1.d 
+	@${RM} ${OBJECTDIR}/hasard.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/hasard.p1 hasard.c 
+	@-${MV} ${OBJECTDIR}/hasard.d ${OBJECTDIR}/hasard.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/hasard.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/regles.p1: regles.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/regles.p1.d 
+	@${RM} ${OBJECTDIR}/regles.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/regles.p1 regles.c 
+	@-${MV} ${OBJECTDIR}/regles.d ${OBJECTDIR}/regles.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/regles.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/moniteur.p1: moniteur.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/moniteur.p1.d 
+	@${RM} ${OBJECTDIR}/moniteur.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/moniteur.p1 moniteur.c 
+	@-${MV} ${OBJECTDIR}/moniteur.d ${OBJECTDIR}/moniteur.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/moniteur.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/veille.p1: veille.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/veille.p1.d 
+	@${RM} ${OBJECTDIR}/veille.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/veille.p1 veille.c 
+	@-${MV} ${OBJECTDIR}/veille.d ${OBJECTDIR}/veille.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/veille.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/mesure.p1: mesure.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/mesure.p1.d 
+	@${RM} ${OBJECTDIR}/mesure.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/mesure.p1 mesure.c 
+	@-${MV} ${OBJECTDIR}/mesure.d ${OBJECTDIR}/mesure.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/mesure.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/masque.p1: masque.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/masque.p1.d 
+	@${RM} ${OBJECTDIR}/masque.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/masque.p1 masque.c 
+	@-${MV} ${OBJECTDIR}/masque.d ${OBJECTDIR}/masque.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/masque.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/stats.p1: stats.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/stats.p1.d 
+	@${RM} ${OBJECTDIR}/stats.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/stats.p1 stats.c 
+	@-${MV} ${OBJECTDIR}/stats.d ${OBJECTDIR}/stats.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/stats.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/entrees.p1: entrees.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/entrees.p1.d 
+	@${RM} ${OBJECTDIR}/entrees.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/entrees.p1 entrees.c 
+	@-${MV} ${OBJECTDIR}/entrees.d ${OBJECTDIR}/entrees.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/entrees.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/commande.p1: commande.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/commande.p1.d 
+	@${RM} ${OBJECTDIR}/commande.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/commande.p1 commande.c 
+	@-${MV} ${OBJECTDIR}/commande.d ${OBJECTDIR}/commande.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/commande.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/solveur.p1: solveur.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/solveur.p1.d 
+	@${RM} ${OBJECTDIR}/solveur.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -fshort-double -fshort-float -memi=wordwrite -O0 -fasmfile -flocal -maddrqual=ignore -xassembler-with-cpp -mwarn=0 -Wa,-a -DXPRJ_Mini_board_config=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c90 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/solveur.p1 solveur.c 
+	@-${MV} ${OBJECTDIR}/solveur.d ${OBJECTDIR}/solveur.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/solveur.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 endif
 
 # ------------------------------------------------------------------------------------
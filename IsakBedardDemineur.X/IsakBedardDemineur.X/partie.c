@@ -0,0 +1,232 @@
+/**
+ * @file   partie.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Droulement d'une partie: un tick de la boucle principale, nouvelle
+ * partie, clic, affichage.
+ *
+ * Ces fonctions n'utilisent que les modules du jeu (regles.c, solveur.c),
+ * le LCD (Lcd4Lignes.c), les entres (entrees_lit()), les statistiques et le
+ * moniteur, jamais un registre directement. hote/Makefile les compile
+ * aussi sur l'ordinateur avec une carte mule (hote/carte.c): un
+ * enregistrement des entres y est rejou exactement comme sur le PIC
+ * (hote/rejeu.c).
+ */
+
+#include "Lcd4Lignes.h" //LCD (registres muls sur l'ordinateur)
+#include "demineur.h" //constantes et tableaux partags du jeu
+#include "solveur.h" //solveur logique du mode sans devinette
+#include "entrees.h" //lecture des entres par tick, enregistrement et rejeu
+#include "stats.h" //statistiques des parties dans l'EEPROM
+#include "moniteur.h" //chance des ticks (chaque tche est annonce avec moniteur_tache())
+
+LOCAL_FIL bool m_sansDevinette = false; //vrai si les champs gnrs doivent se rsoudre sans deviner
+
+/*
+ * @brief Traite un tick de la boucle principale: attend le tick et lit les
+ *  entres, dplace le curseur, puis dvoile la case ou y met un drapeau.
+ *  Aprs une partie termine et pour l'antirebond de SW0, les ticks suivants
+ *  sont lus ici mme. Les commandes du port srie sont traites par main()
+ *  entre deux appels.
+ * @param rien
+ * @return rien
+ */
+void traiteTick(void)
+{
+    uint8_t entrees = entrees_lit(); //attend le prochain tick et lit le joystick et les boutons
+
+    moniteur_tache(TACHE_DEPLACE);
+    deplace(entrees); //on dplace le curseur
+    if(entrees & ENTREE_SW)//si le bouton du joystick est enfonc
+    {
+        moniteur_tache(TACHE_JOUE);
+        if(joue(m_partie.x, m_partie.y) == PARTIE_EN_COURS)
+        {
+            moniteur_tache(TACHE_AFFICHAGE);
+            afficheTabVue();//actualise le LCD pour afficher la nouvelle matrice
+        }
+        else //si on a gagn ou perdu (trouv toutes les mines ou touch une mine)
+        {
+            moniteur_tache(TACHE_AFFICHAGE);
+            afficheTabMines(m_partie.x, m_partie.y);
+            while(!(entrees_lit() & ENTREE_SW)); //on affiche m_tabMines jusqu' ce que le bouton du joystick soit renfonc
+            moniteur_tache(TACHE_PARTIE);
+            nouvellePartie(); //on rinitialise les deux matrices.
+            avertitSansGarantie();
+        }
+    }
+    if(entrees & ENTREE_SW0) //si le bouton sur la carte noire est enfonc
+    {
+        moniteur_tache(TACHE_DRAPEAU);
+        metOuEnleveDrapeau(m_partie.x, m_partie.y); //appel de la fonction qui gre les drapeaux
+        moniteur_tache(TACHE_AFFICHAGE);
+        afficheTabVue();//on actualise le LCD pour affiche la nouvelle matrice
+        while(entrees_lit() & ENTREE_SW0);//boucle antirebond qui attend que le bouton de la carte noire soit relch
+    }
+}
+
+/*
+ * @brief Prpare une nouvelle partie et l'affiche. Voir preparePartie().
+ * @param rien
+ * @return rien
+ */
+void nouvellePartie(void)
+{
+    preparePartie();
+    afficheTabVue();
+}
+
+/*
+ * @brief Prpare une nouvelle partie sans rien afficher: rempli m_tabMines
+ *  et met les tuiles dans m_tabVue. N'utilise pas le LCD, ce qui permet de
+ *  l'appeler au dmarrage avant lcd_init(). En mode sans devinette, le champ
+ *  est gnr par solveur_genere() et la case de dpart trouve par le
+ *  solveur est dvoile pour le joueur. m_partie.garanti est faux si le
+ *  solveur n'a pas trouv de champ qui se rsout sans deviner.
+ *  Le nombre de mines est celui de m_partie.
+ * @param rien
+ * @return rien
+ */
+void preparePartie(void)
+{
+    uint8_t departX = 0, departY = 0; //case vide de dpart choisie par le solveur
+
+    stats_debutPartie(m_partie.nbMines);
+    if (m_sansDevinette)
+        m_partie.garanti = solveur_genere(m_partie.nbMines, &departX, &departY);
+    else {
+        rempliMines(m_partie.nbMines);
+        metToucheCombien();
+        m_partie.garanti = true; //rien n'a t promis
+    }
+
+    initTabVue(); //on efface le travail du solveur
+    if (departX != 0)
+        enleveTuilesAutour(departX, departY); //dvoile la case de dpart
+}
+
+/*
+ * @brief En mode sans devinette, prvient le joueur quand le champ n'a pas
+ *  pu tre valid (trop de mines pour le nombre d'essais): le message reste
+ *  affich jusqu' ce que le bouton du joystick soit enfonc, puis le champ
+ *  est affich. Ne fait rien si le champ est garanti.
+ * @param rien
+ * @return rien
+ */
+void avertitSansGarantie(void)
+{
+    if (m_partie.garanti)
+        return;
+    lcd_effaceAffichage();
+    lcd_gotoXY(1, 2);
+    lcd_putMessage("Champ non garanti:");
+    lcd_gotoXY(1, 3);
+    lcd_putMessage("il faudra deviner");
+    while(entrees_lit() & ENTREE_SW); //le bouton qui a fini la partie prcdente est peut-tre encore enfonc
+    while(!(entrees_lit() & ENTREE_SW));
+    while(entrees_lit() & ENTREE_SW); //attend le relchement: cet appui ne doit pas dvoiler de case
+    afficheTabVue();
+}
+
+/**
+ * @brief Si la manette est vers la droite ou la gauche, on dplace le curseur 
+ * d'une position (gauche, droite, bas et haut). La position est celle de
+ * m_partie.
+ * @param uint8_t entrees L'tat des entres lu par entrees_lit()
+ * @return rien
+ */
+void deplace(uint8_t entrees) 
+{
+    if (entrees & ENTREE_GAUCHE) //si le joystick est vers la gauche
+    {
+        if (m_partie.x == 1) //si on dpasserait de l'cran
+            m_partie.x = NB_COL; //on revient de l'autre ct
+        else
+            m_partie.x--; //dcale la position de 1 vers la gauche
+    } else if (entrees & ENTREE_DROITE) //si le joystick est vers la droite
+    {
+        if (m_partie.x == NB_COL) //si on dpasserait de l'cran
+            m_partie.x = 1; //on revient de l'autre ct
+        else
+            m_partie.x++; //dcale la position de 1 vers la droite
+    }
+
+    if (entrees & ENTREE_HAUT) //si le joystick est vers le haut
+    {
+        if (m_partie.y == 1) //si on dpasserait de l'cran
+            m_partie.y = NB_LIGNE; //on revient de l'autre ct
+        else
+            m_partie.y--; //dcale la position de 1 vers le haut
+    } else if (entrees & ENTREE_BAS) //si le joystick est vers le bas
+    {
+        if (m_partie.y == NB_LIGNE) //si on dpasserait de l'cran
+            m_partie.y = 1; //on revient de l'autre ct
+        else
+            m_partie.y++; //dcale la position de 1 vers le bas
+    }
+    lcd_gotoXY(m_partie.x, m_partie.y); //on met le curseur  la nouvelle position.
+}
+
+/*
+ * @brief Joue un clic sur une case: la dvoile, puis vrifie si la partie est
+ * termine et l'enregistre dans les statistiques si c'est le cas. Sert autant
+ * au bouton du joystick qu'aux commandes reues par le port srie.
+ * N'actualise pas le LCD: une suite de coups reue d'un bloc par le port
+ * srie n'est affiche qu'une fois,  la fin.
+ * Si on a gagn, le nombre de mines de m_partie est augment de 1.
+ * @param uint8_t x, uint8_t y Les positions X et y sur l'afficheur LCD
+ * @return PARTIE_EN_COURS, PARTIE_GAGNEE ou PARTIE_PERDUE
+ */
+char joue(uint8_t x, uint8_t y)
+{
+    stats_clic();
+    if (demine(x, y) == false) //on a touch une mine
+    {
+        stats_finPartie(false); //l'enregistrement s'crit en arrire-plan dans l'EEPROM
+        return PARTIE_PERDUE;
+    }
+    if (gagne()) //on a trouv toutes les mines
+    {
+        stats_finPartie(true);
+        return PARTIE_GAGNEE;
+    }
+    return PARTIE_EN_COURS;
+}
+
+/*
+ * @brief Affiche le tableau m_tabVue.
+ * @param rien
+ * @return rien
+ */
+void afficheTabVue(void) 
+{
+    for (char i = 0; i < NB_LIGNE; i++) {//pour toutes les lignes  crire
+        lcd_gotoXY(1, i + 1);//on se dplace au dbut de la ligne  crire
+        lcd_putMessage(m_tabVue[i]);//on crit la ligne
+    }
+}
+
+/*
+ * @brief Affiche le tableau m_tabMines  la fin de la partie. La mine de la
+ * case joue (s'il y en a une) et les mines touches par un accord (notes
+ * MINE_EXPLOSEE dans m_tabVue) sont affiches exploses, et les drapeaux de
+ * m_tabVue restent affichs: barrs s'il n'y avait pas de mine dessous.
+ * @param uint8_t x, uint8_t y La dernire case joue
+ * @return rien
+ */
+void afficheTabMines(uint8_t x, uint8_t y) 
+{
+    char car; //caractre affich pour la case
+
+    for (char i = 0; i < NB_LIGNE; i++) {//pour toutes les lignes  crire
+        lcd_gotoXY(1, i + 1);//on se dplace au dbut de la ligne  crire
+        for (char j = 0; j < NB_COL; j++) {
+            car = m_tabMines[i][j];
+            if (m_tabVue[i][j] == DRAPEAU)
+                car = (car == MINE) ? DRAPEAU : DRAPEAU_FAUX;
+            else if (car == MINE && (m_tabVue[i][j] == MINE_EXPLOSEE || (i == y - 1 && j == x - 1)))
+                car = MINE_EXPLOSEE;
+            lcd_ecritChar(car);
+        }
+    }
+}
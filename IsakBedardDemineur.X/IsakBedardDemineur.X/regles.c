@@ -0,0 +1,302 @@
+/**
+ * @file   regles.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Rgles du jeu: placement des mines, chiffres, dvoilement, drapeaux
+ * et vrification de la victoire.
+ *
+ * Ces fonctions ne touchent qu'aux tableaux du jeu (m_tabMines, m_tabVue) et
+ *  m_partie: aucun registre, aucun affichage. C'est ce qui permet de les
+ * compiler aussi sur l'ordinateur, avec le banc d'essai du dossier hote/.
+ */
+
+#include "demineur.h"
+#include "hasard.h"
+
+#define A_OUVRIR 6 //case vide dvoile par un accord, voisines pas encore dvoiles. Jamais affiche
+
+static bool devoileAutour(uint8_t x, uint8_t y);
+static bool ouvreAutour(uint8_t x, uint8_t y);
+static void ouvreZonesVides(void);
+
+LOCAL_FIL Partie m_partie = {X_DEPART, Y_DEPART, NB_MINES_DEPART, true}; //la partie en cours
+LOCAL_FIL char m_tabVue[NB_LIGNE][NB_COL + 1]; //Tableau des caractres affichs au LCD
+LOCAL_FIL char m_tabMines[NB_LIGNE][NB_COL + 1]; //Tableau contenant les mines, les espaces et les chiffres
+
+/*
+ * @brief Rempli le tableau m_tabVue avec le caractre spcial (dfinie en CGRAM
+ *  du LCD) TUILE. Met un '\0'  la fin de chaque ligne pour faciliter affichage
+ *  avec lcd_putMessage().
+ * @param rien
+ * @return rien
+ */
+void initTabVue(void) 
+{
+    for (char i = 0; i < NB_LIGNE; i++) {
+        for (char j = 0; j < NB_COL; j++) { 
+            m_tabVue[i][j] = TUILE; //on met des tuiles
+        }
+        m_tabVue[i][NB_COL] = 0; //le dernier caractre de la ligne est 0 ou '\0'
+    }
+}
+
+/*
+ * @brief Rempli le tableau m_tabMines d'un nombre (nb) de mines au hasard.
+ *  Les cases vides contiendront le code ascii d'un espace et les cases avec
+ *  mine contiendront le caractre MINE dfini en CGRAM.
+ * @param uint8_t nb, le nombre de mines  mettre dans le tableau 
+ * @return rien
+ */
+void rempliMines(uint8_t nb) 
+{
+    uint8_t x, y; //la position en XY de la mine
+
+    for (char i = 0; i < NB_LIGNE; i++) {
+        for (char j = 0; j < NB_COL; j++) {
+            m_tabMines[i][j] = ' '; //on met tout le tableau vide (avec des espaces)
+        }
+    }
+    while (nb > 0) { //tant que le nombre de mines voulu n'a pas t atteint
+        x = hasard() % NB_COL;
+        y = hasard() % NB_LIGNE; //on assigne des valeurs XY alatoires
+        if (m_tabMines[y][x] != MINE) { //si la position alatoire est diponible
+            m_tabMines[y][x] = MINE; //on place une mine
+            nb--; //il reste une mine de moins  placer
+        }
+    }
+}
+
+/*
+ * @brief Rempli le tableau m_tabMines avec le nombre de mines que touche la case.
+ * Si une case touche  3 mines, alors la mthode place le code ascii de 3 dans
+ * le tableau. Si la case ne touche  aucune mine, la mthode met le code
+ * ascii d'un espace.
+ * Pour chaque ligne, on compte d'abord les mines de chaque colonne sur les
+ * lignes du dessus, du centre et du dessous. Une case touche alors  la somme
+ * de sa colonne et des deux colonnes voisines. Le tableau des colonnes a une
+ * colonne vide de chaque ct: aucune vrification de bord dans le calcul.
+ * @param rien
+ * @return rien
+ */
+void metToucheCombien(void) 
+{
+    char colonnes[NB_COL + 2]; //mines des lignes voisines par colonne, avec une colonne vide de chaque ct
+    char nbMines; //nombre de mines autour de la case
+    bool dessus, dessous; //vrai si la ligne du dessus (du dessous) existe
+
+    colonnes[0] = 0;
+    colonnes[NB_COL + 1] = 0; //les colonnes de garde ne contiennent jamais de mine
+    for (char i = 0; i < NB_LIGNE; i++) {
+        dessus = (i > 0);
+        dessous = (i < NB_LIGNE - 1); //les bords sont traits une fois par ligne, pas par case
+        for (char j = 0; j < NB_COL; j++) {
+            colonnes[j + 1] = (m_tabMines[i][j] == MINE);
+            if (dessus && m_tabMines[i - 1][j] == MINE)
+                colonnes[j + 1]++;
+            if (dessous && m_tabMines[i + 1][j] == MINE)
+                colonnes[j + 1]++;
+        }
+        for (char j = 0; j < NB_COL; j++) {
+            if (m_tabMines[i][j] != MINE) {
+                nbMines = colonnes[j] + colonnes[j + 1] + colonnes[j + 2];
+                if (nbMines == 0) //s'il y a 0 mines autour (afficherait 0)
+                    m_tabMines[i][j] = ' '; //on remplace par un espace pour tre plus fidle au jeu original
+                else
+                    m_tabMines[i][j] = nbMines + '0'; //on met le caractre ASCII du nombre de mines autour de la case dans la case
+            }
+        }
+    }
+}
+
+/*
+ * @brief Dvoile une tuile (case) de m_tabVue. 
+ * S'il y a une mine, retourne Faux. Sinon remplace la case et les cases autour
+ * par ce qu'il y a derrire les tuiles (m_tabMines).
+ * Utilise enleveTuileAutour(). Ne dvoile rien si la case slectionne est un drapeau.
+ * Si la case est un chiffre dj dvoil, dvoile ses voisines avec devoileAutour().
+ * N'actualise pas le LCD: c'est  l'appelant d'appeler afficheTabVue().
+ * @param uint8_t x, uint8_t y Les positions X et y sur l'afficheur LCD
+ * @return faux s'il y avait une mine, vrai sinon
+ */
+bool demine(uint8_t x, uint8_t y) 
+{
+    if (m_tabMines[y - 1][x - 1] == MINE)//si la case slectionne est une mine
+        return false;//retourne faux (on a perdu)
+    else 
+    {
+        if (m_tabMines[y-1][x-1]==' ')//si c'est un espace (donc pas une mine ou pas un chiffre)
+        {
+            enleveTuilesAutour(x, y);//on enlve les tuiles autour
+        }
+        else if (m_tabVue[y-1][x-1]==m_tabMines[y-1][x-1])//si le chiffre est dj dvoil
+        {
+            return devoileAutour(x, y);//on dvoile ses voisines d'un coup
+        }
+        else if (m_tabVue[y-1][x-1]!=DRAPEAU)//si ce n'est pas un drapeau (donc un chiffre)
+        {
+            m_tabVue[y-1][x-1]=m_tabMines[y-1][x-1];//on actualise seulement la case slectionne, pas celles autour
+        }
+        return true;//retourne vrai (on a pas perdu)
+    }
+}
+
+/*
+ * @brief Dvoile les cases non mines autour de la tuile reue en paramtre.
+ * Cette mthode est appele par demine(). Ne devoile pas non plus les cases avec
+ * drapeaux. N'actualise pas le LCD: c'est  l'appelant d'appeler afficheTabVue().
+ * @param uint8_t x, uint8_t y Les positions X et y sur l'afficheur LCD.
+ * @return vrai si au moins une tuile a t enleve
+ */
+bool enleveTuilesAutour(uint8_t x, uint8_t y) 
+{
+    bool enleve = false;
+    char ligneMax = VOISIN_MAX(y - 1, NB_LIGNE);
+    char colonneMax = VOISIN_MAX(x - 1, NB_COL); //bornes du 3x3 calcules une seule fois, sans dpasser du LCD
+
+    for (char j = VOISIN_MIN(y - 1); j <= ligneMax; j++)
+    {
+        for (char i = VOISIN_MIN(x - 1); i <= colonneMax; i++) //on fait le 3x3 autour de la case voulue
+        { 
+            if(m_tabVue[j][i]==TUILE && m_tabMines[j][i]!=MINE) //si la case vrifie dans le 3x3 est une tuile sans mine (pas un drapeau)
+            {
+                m_tabVue[j][i]=m_tabMines[j][i]; //on la dvoile
+                enleve = true;
+            }
+        }
+    }
+    return enleve;
+}
+
+/*
+ * @brief Dvoile d'un coup les voisines d'un chiffre dj dvoil, si le
+ * joueur a mis autour autant de drapeaux que le chiffre. Les zones vides
+ * ainsi dvoiles sont ouvertes aussi. N'actualise pas le LCD: tout le coup
+ * est affich en une fois par l'appelant.
+ * Si un drapeau est mal plac, les mines voisines sans drapeau sont notes
+ * MINE_EXPLOSEE dans m_tabVue, pour que l'affichage de fin de partie montre
+ * la mine touche et non le chiffre jou.
+ * @param uint8_t x, uint8_t y Les positions X et y du chiffre sur l'afficheur LCD
+ * @return faux si un drapeau tait mal plac (une tuile voisine cachait une
+ * mine), vrai sinon
+ */
+static bool devoileAutour(uint8_t x, uint8_t y)
+{
+    char ligneMax = VOISIN_MAX(y - 1, NB_LIGNE);
+    char colonneMax = VOISIN_MAX(x - 1, NB_COL);
+    char nbDrapeaux = 0; //drapeaux autour du chiffre
+    bool touche = false; //vrai si une tuile voisine cache une mine
+
+    for (char j = VOISIN_MIN(y - 1); j <= ligneMax; j++)
+        for (char i = VOISIN_MIN(x - 1); i <= colonneMax; i++)
+            if (m_tabVue[j][i] == DRAPEAU)
+                nbDrapeaux++;
+    if (nbDrapeaux != m_tabMines[y - 1][x - 1] - '0') //pas assez (ou trop) de drapeaux: on ne fait rien
+        return true;
+
+    for (char j = VOISIN_MIN(y - 1); j <= ligneMax; j++)
+        for (char i = VOISIN_MIN(x - 1); i <= colonneMax; i++)
+            if (m_tabVue[j][i] == TUILE && m_tabMines[j][i] == MINE) { //un drapeau est ailleurs que sur cette mine
+                m_tabVue[j][i] = MINE_EXPLOSEE;
+                touche = true;
+            }
+    if (touche)
+        return false;
+    if (ouvreAutour(x, y)) //toutes les tuiles voisines sont sans mine
+        ouvreZonesVides();
+    return true;
+}
+
+/*
+ * @brief Dvoile les tuiles sans mine du 3x3 autour d'une case, comme
+ * enleveTuilesAutour(), mais note A_OUVRIR les cases vides dvoiles: leurs
+ * voisines restent  dvoiler par ouvreZonesVides().
+ * @param uint8_t x, uint8_t y Les positions X et y sur l'afficheur LCD
+ * @return vrai si au moins une case vide a t dvoile
+ */
+static bool ouvreAutour(uint8_t x, uint8_t y)
+{
+    bool vide = false;
+    char ligneMax = VOISIN_MAX(y - 1, NB_LIGNE);
+    char colonneMax = VOISIN_MAX(x - 1, NB_COL);
+
+    for (char j = VOISIN_MIN(y - 1); j <= ligneMax; j++)
+        for (char i = VOISIN_MIN(x - 1); i <= colonneMax; i++)
+            if (m_tabVue[j][i] == TUILE && m_tabMines[j][i] != MINE) {
+                if (m_tabMines[j][i] == ' ') {
+                    m_tabVue[j][i] = A_OUVRIR;
+                    vide = true;
+                } else
+                    m_tabVue[j][i] = m_tabMines[j][i];
+            }
+    return vide;
+}
+
+/*
+ * @brief Ouvre les zones vides dvoiles par un accord: chaque case A_OUVRIR
+ * redevient un espace et dvoile ses voisines, qui peuvent  leur tour tre
+ * A_OUVRIR. Seules les cases dvoiles par ce coup sont ouvertes: une case
+ * vide dvoile plus tt (un clic n'ouvre que son 3x3) reste comme elle est.
+ * Pas de rcursion (pile compile du XC8): on refait des passes sur le champ
+ * tant qu'une passe a trouv une case A_OUVRIR. Chaque case n'est note
+ * A_OUVRIR qu'une fois, et les zones s'tendent aussi pendant une passe: il
+ * en faut rarement plus de deux ou trois.
+ * @param rien
+ * @return rien
+ */
+static void ouvreZonesVides(void)
+{
+    bool change;
+
+    do {
+        change = false;
+        for (char j = 0; j < NB_LIGNE; j++)
+            for (char i = 0; i < NB_COL; i++)
+                if (m_tabVue[j][i] == A_OUVRIR) {
+                    m_tabVue[j][i] = ' ';
+                    ouvreAutour(i + 1, j + 1);
+                    change = true;
+                }
+    } while (change);
+}
+
+/*
+ * @brief Vrifie si gagn. On a gagn quand le nombre de tuiles non dvoiles
+ * est gal au nombre de mines. On augmente de 1 le nombre de mines si on a 
+ * gagn. Le nombre de mines est celui de m_partie.
+ * @param rien
+ * @return vrai si gagn, faux sinon
+ */
+bool gagne(void) 
+{
+    uint8_t nbTuileEtDrapeau=0; //valeur de comparaison. doit tre gale  la somme du nombre de drapeaux et du nombre de tuiles dans m_tabVue
+    
+    for (char i = 0; i < NB_LIGNE; i++) {
+        for (char j = 0; j < NB_COL; j++) {//on parcourt le LCD au complet
+            if(m_tabVue[i][j]==TUILE||m_tabVue[i][j]==DRAPEAU) //si c'est un drapeau ou une tuile
+                nbTuileEtDrapeau++;//on incrmente
+        }
+    }
+    if (nbTuileEtDrapeau == m_partie.nbMines)//si la valeur compte prcdemment correspond au nombre de mines
+    {
+        m_partie.nbMines++; //on augmente le nombre de mines  placer pour la prochaine partie
+        return true;//retourne vrai (on a gagn)
+    }
+    else
+        return false;//retourne faux (on a pas gagn)
+}
+
+/*
+ * @brief Remplace la tuile slectionne avec un drapeau dans m_tabVue. Si la case slectionne
+ * est un drapeau, on l'enlve. Les drapeaux ne sont pas enlevs par enleveTuilesAutour.
+ * On peut placer un drapeau seulement sur une tuile (pas une case vide ou chiffre).
+ * N'actualise pas le LCD.
+ * @param uint8_t x, uint8_t y la position du curseur sur le LCD
+ * @return rien
+ */
+void metOuEnleveDrapeau(uint8_t x, uint8_t y) 
+{
+    if (m_tabVue[y-1][x-1]==TUILE)//si la case slectionne est une tuile
+        m_tabVue[y-1][x-1]=DRAPEAU;//on la remplace par un drapeau
+    else if (m_tabVue[y-1][x-1]==DRAPEAU)//sinon, si c'est un drapeau
+        m_tabVue[y-1][x-1]=TUILE;//on le remplace avec une tuile
+}
@@ -7,6 +7,11 @@
  * mais on doit crire le code.
  * Aussi, on trouve le code d'initialisation du port srie init_serie() dont
  * le prototype est dfini dans serie.h.
+ * La rception se fait par interruption dans un tampon circulaire: le UART
+ * du PIC ne garde que 2 caractres, ce qui ne suffit pas quand l'hte envoie
+ * des commandes pendant que le jeu affiche ou calcule. L'interruption est
+ * seule  avancer m_tete et le programme principal seul  avancer m_queue:
+ * aucun verrou n'est ncessaire.
  * @version 1.0
  * Environnement:
  *     Dveloppement: MPLAB X IDE (version 3.50)
@@ -18,6 +23,13 @@
 #include <xc.h>
 #include <conio.h>
 #include "serie.h"
+#include "veille.h"
+
+#define TAILLE_TAMPON 32 //caractres reus en attente, puissance de 2
+
+static volatile unsigned char m_tampon[TAILLE_TAMPON]; //caractres reus pas encore lus
+static volatile unsigned char m_tete = 0; //prochaine case crite par l'interruption
+static volatile unsigned char m_queue = 0; //prochaine case lue par getch()
 
 /**
  * @brief Initialise les registres pour utiliser le port srie EUSART
@@ -45,8 +57,34 @@ void init_serie(void)
     RCSTAbits.CREN = 1; //enable rx
     RCSTAbits.SPEN=1;  //enable EUSART et config pin tx en sortie
     ANSEL = 0;         //mode analogique disable 
+    PIE1bits.RCIE = 1; //interruption  chaque caractre reu (GIE et PEIE activs par le main)
 }    
 
+/**
+ * @brief  Interruption de rception: place le caractre reu dans le tampon.
+ *         Si le tampon est plein, le caractre est perdu.
+ * @param  Rien
+ * @return Rien
+ */
+void serie_interruption(void)
+{
+    unsigned char suivante;
+
+    if (RCSTAbits.OERR) //dbordement du UART: on le rarme, sinon plus rien n'est reu
+    {
+        RCSTAbits.CREN = 0;
+        RCSTAbits.CREN = 1;
+    }
+    suivante = (m_tete + 1) & (TAILLE_TAMPON - 1);
+    if (suivante != m_queue)
+    {
+        m_tampon[m_tete] = RCREG; // va chercher le caractre du UART (efface RCIF)
+        m_tete = suivante;
+    }
+    else
+        suivante = RCREG;      // tampon plein: on vide quand mme le UART
+}
+
 
 
 /**
@@ -71,9 +109,15 @@ char getch(void)
 {
     unsigned char c;
 
-    while (!RCIF)
-        ;               // Attend que le port reoive un caractre
-    c = RCREG;         // va chercher le caractre du UART
+    while (m_queue == m_tete)
+    {                   // Attend en veille que l'interruption reoive un caractre
+        di();
+        if (m_queue == m_tete)
+            veille_dort();
+        ei();
+    }
+    c = m_tampon[m_queue];         // va chercher le caractre dans le tampon
+    m_queue = (m_queue + 1) & (TAILLE_TAMPON - 1);
     
     return c;
 }
@@ -85,9 +129,7 @@ char getch(void)
  */
 char getche(void)
 {
-    unsigned char c;
-    while (!RCIF);     // Attend que le port reoive un caractre
-    c = RCREG;         // va chercher le caractre du UART
+    unsigned char c = getch();
     
     //echo
     while(TXSTAbits.TRMT==0); //attend que buffer de tx est vide
@@ -103,11 +145,34 @@ char getche(void)
  */
 bit kbhit(void)
 {
-    return RCIF;
+    return m_queue != m_tete;
 }
 
+/**
+ * @brief  Envoyer une chane sur le port srie.
+ * @param  texte La chane  envoyer, termine par '\0'
+ * @return Rien
+ */
+void serie_envoieTexte(const char* texte)
+{
+    while (*texte != 0)
+        putch(*texte++);
+}
 
-
-
-
-
+/**
+ * @brief  Envoyer un nombre en dcimal sur le port srie.
+ * @param  valeur Le nombre  envoyer
+ * @return Rien
+ */
+void serie_envoieNombre(unsigned long valeur)
+{
+    char chiffres[10]; //2^32 a 10 chiffres
+    char nb = 0;
+
+    do {
+        chiffres[nb++] = valeur % 10 + '0';
+        valeur /= 10;
+    } while (valeur != 0);
+    while (nb > 0)
+        putch(chiffres[--nb]);
+}
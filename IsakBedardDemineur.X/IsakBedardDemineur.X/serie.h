@@ -2,13 +2,16 @@
  * @File:  serie.h
  * @author Benoit Beaulieu
  * @date   Mai 2017
- * @brief  Prototype de la fonction init_serie()
+ * @brief  Prototypes des fonctions du port srie qui ne sont pas dans conio.h
 */
 
 #ifndef SERIE_H
 #define	SERIE_H
 
 void init_serie(void);
+void serie_interruption(void);
+void serie_envoieTexte(const char* texte);
+void serie_envoieNombre(unsigned long valeur);
 
 #endif	/* SERIE_H */
 
@@ -0,0 +1,410 @@
+/**
+ * @file   solveur.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Solveur logique pour le mode "sans devinette".
+ *
+ * Le solveur joue la partie  la place du joueur dans m_tabVue. Il ne connat
+ * que ce qu'un joueur verrait: les cases dvoiles et les drapeaux qu'il a
+ * lui-mme dduits. Pour chaque chiffre dvoil, il applique les deux rgles
+ * de base du dmineur:
+ *   - si le nombre de drapeaux autour gale le chiffre, les tuiles autour
+ *     sont sres et on les dvoile;
+ *   - si drapeaux + tuiles autour gale le chiffre, les tuiles autour sont
+ *     toutes des mines et on y met un drapeau.
+ * Quand ces rgles ne suffisent plus, on compare les cases voisines deux 
+ * deux (voir solveur_deduitPaire()). Une fois toutes les mines trouves, les tuiles restantes sont sres.
+ * Si plus rien ne peut tre dduit avant d'avoir tout dvoil, le joueur
+ * aurait d deviner. Le champ est alors rpar: une mine qui bloque le
+ * solveur (une tuile mine au bord de la zone dvoile) est dplace sur une
+ * tuile loin de cette zone, puis le champ est revalid depuis la mme case
+ * de dpart. On ne gnre un nouveau champ que si la rparation est
+ * impossible. Aucun registre n'est utilis: le solveur se compile aussi sur
+ * l'ordinateur (voir hote/).
+ */
+
+#include "demineur.h"
+#include "hasard.h"
+#include "solveur.h"
+
+#define NB_VALIDATIONS 20 //passages du solveur au plus par partie, rparations comprises
+
+LOCAL_FIL unsigned char m_nbValidations; //passages du solveur pendant le dernier solveur_genere()
+
+static LOCAL_FIL unsigned char m_nbOuvertes; //nombre de cases dvoiles par le solveur
+static LOCAL_FIL unsigned char m_nbDrapeaux; //nombre de mines dduites par le solveur
+
+static bool solveur_valide(uint8_t nb, uint8_t x, uint8_t y);
+static bool solveur_repare(void);
+static bool solveur_bordOuvert(char ligne, char colonne);
+static bool solveur_choisitDepart(uint8_t* x, uint8_t* y);
+static bool solveur_premiereVide(uint8_t* x, uint8_t* y);
+static bool solveur_deduit(char ligne, char colonne);
+static bool solveur_deduitPaire(char ligne, char colonne);
+static signed char solveur_restant(char ligne, char colonne, char* nbTuiles);
+static void solveur_marqueVoisins(char ligne, char colonne, bool mine);
+static void solveur_ouvre(char ligne, char colonne);
+
+/*
+ * @brief Gnre un champ qui se rsout sans deviner. Voir solveur.h.
+ * @param uint8_t nb, uint8_t* x, uint8_t* y Voir solveur.h
+ * @return vrai si le champ se rsout par la logique seulement
+ */
+bool solveur_genere(uint8_t nb, uint8_t* x, uint8_t* y)
+{
+    bool nouveau = true; //vrai s'il faut gnrer un nouveau champ
+
+    m_nbValidations = 0;
+    *x = 0;
+    *y = 0;
+    while (m_nbValidations < NB_VALIDATIONS) {
+        if (nouveau) {
+            rempliMines(nb);
+            metToucheCombien();
+            if (solveur_choisitDepart(x, y) == false) { //aucune case vide: il faudrait deviner ds le premier coup
+                m_nbValidations++;
+                continue;
+            }
+        }
+        initTabVue(); //le solveur joue dans m_tabVue
+        m_nbValidations++;
+        if (solveur_valide(nb, *x, *y))
+            return true;
+        nouveau = !solveur_repare(); //la case de dpart reste vide aprs une rparation
+        if (!nouveau)
+            metToucheCombien();
+    }
+    return false; //le dernier champ essay reste dans m_tabMines
+}
+
+/*
+ * @brief Valide un champ dj dans m_tabMines depuis sa premire case vide.
+ * Voir solveur.h.
+ * @param uint8_t nb Le nombre de mines du champ
+ * @return vrai si le champ (rpar au besoin) se rsout sans deviner
+ */
+bool solveur_verifie(uint8_t nb)
+{
+    uint8_t x, y; //case de dpart
+
+    m_nbValidations = 0;
+    while (m_nbValidations < NB_VALIDATIONS) {
+        if (solveur_premiereVide(&x, &y) == false) //aucune case vide: il faudrait deviner ds le premier coup
+            return false;
+        initTabVue();
+        m_nbValidations++;
+        if (solveur_valide(nb, x, y))
+            return true;
+        if (solveur_repare() == false)
+            return false;
+        metToucheCombien(); //une rparation peut crer une case vide avant la case de dpart: on la recherche
+    }
+    return false;
+}
+
+/*
+ * @brief Vrifie si le champ courant se rsout sans deviner. m_tabVue doit
+ * contenir seulement des tuiles; il contient au retour ce que le solveur a
+ * dvoil ou dduit.
+ * @param uint8_t nb Le nombre de mines du champ
+ * @param uint8_t x, uint8_t y La case de dpart, vide (1  20, 1  4)
+ * @return vrai si le champ se rsout par la logique seulement
+ */
+static bool solveur_valide(uint8_t nb, uint8_t x, uint8_t y)
+{
+    bool progres = true; //vrai tant qu'une passe a permis de dduire quelque chose
+
+    m_nbOuvertes = 0;
+    m_nbDrapeaux = 0;
+    solveur_ouvre(y - 1, x - 1); //le premier coup est donn au joueur
+
+    while (progres && m_nbOuvertes < NB_LIGNE * NB_COL - nb) {
+        progres = false;
+        for (char i = 0; i < NB_LIGNE; i++) {
+            for (char j = 0; j < NB_COL; j++) {
+                if (solveur_deduit(i, j))
+                    progres = true;
+            }
+        }
+        for (char i = 0; i < NB_LIGNE && !progres; i++) { //les rgles simples ne suffisent plus
+            for (char j = 0; j < NB_COL && !progres; j++) {
+                if (solveur_deduitPaire(i, j))
+                    progres = true;
+            }
+        }
+        if (m_nbDrapeaux == nb) { //toutes les mines sont trouves, le reste est sr
+            for (char i = 0; i < NB_LIGNE; i++) {
+                for (char j = 0; j < NB_COL; j++) {
+                    if (m_tabVue[i][j] == TUILE)
+                        solveur_ouvre(i, j);
+                }
+            }
+        }
+    }
+    return m_nbOuvertes == NB_LIGNE * NB_COL - nb; //tout a t dvoil sans deviner
+}
+
+/*
+ * @brief Rpare le champ que le solveur n'a pas pu terminer: dplace une
+ * mine pas encore dduite au bord de la zone dvoile vers une tuile sans
+ * mine qui ne touche pas  cette zone. Les chiffres dvoils qui
+ * bloquaient changent; la zone dvoile, elle, garde ses cases vides.
+ * Les deux cases sont choisies au hasard.
+ * @param rien
+ * @return faux s'il n'y a aucune mine  dplacer ou aucune place libre
+ */
+static bool solveur_repare(void)
+{
+    unsigned char nbBloquantes = 0; //mines caches au bord de la zone dvoile
+    unsigned char nbLibres = 0; //tuiles sans mine loin de la zone dvoile
+    unsigned char bloquante, libre; //rang des cases choisies
+
+    for (char i = 0; i < NB_LIGNE; i++) {
+        for (char j = 0; j < NB_COL; j++) {
+            if (m_tabVue[i][j] != TUILE)
+                continue;
+            if (solveur_bordOuvert(i, j)) {
+                if (m_tabMines[i][j] == MINE)
+                    nbBloquantes++;
+            } else if (m_tabMines[i][j] != MINE)
+                nbLibres++;
+        }
+    }
+    if (nbBloquantes == 0 || nbLibres == 0)
+        return false;
+    bloquante = hasard() % nbBloquantes;
+    libre = hasard() % nbLibres;
+    for (char i = 0; i < NB_LIGNE; i++) {
+        for (char j = 0; j < NB_COL; j++) {
+            if (m_tabVue[i][j] != TUILE)
+                continue;
+            if (solveur_bordOuvert(i, j)) {
+                if (m_tabMines[i][j] == MINE && bloquante-- == 0)
+                    m_tabMines[i][j] = ' '; //le chiffre sera recalcul
+            } else if (m_tabMines[i][j] != MINE && libre-- == 0)
+                m_tabMines[i][j] = MINE;
+        }
+    }
+    return true;
+}
+
+/*
+ * @brief Vrifie si une tuile touche  une case dvoile par le solveur.
+ * @param char ligne, char colonne La tuile dans m_tabVue
+ * @return vrai si une des voisines est dvoile
+ */
+static bool solveur_bordOuvert(char ligne, char colonne)
+{
+    char ligneMax = VOISIN_MAX(ligne, NB_LIGNE);
+    char colonneMax = VOISIN_MAX(colonne, NB_COL);
+
+    for (char i = VOISIN_MIN(ligne); i <= ligneMax; i++) {
+        for (char j = VOISIN_MIN(colonne); j <= colonneMax; j++) {
+            if (m_tabVue[i][j] != TUILE && m_tabVue[i][j] != DRAPEAU)
+                return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * @brief Choisit au hasard une case vide (sans mine autour) comme premier coup.
+ * @param uint8_t* x, uint8_t* y Reoivent la position (1  20, 1  4) de la case
+ * @return faux s'il n'y a aucune case vide
+ */
+static bool solveur_choisitDepart(uint8_t* x, uint8_t* y)
+{
+    unsigned char nbVides = 0; //nombre de cases vides dans le champ
+    unsigned char choix; //rang de la case vide choisie
+
+    *x = 0;
+    *y = 0;
+    for (char i = 0; i < NB_LIGNE; i++) {
+        for (char j = 0; j < NB_COL; j++) {
+            if (m_tabMines[i][j] == ' ')
+                nbVides++;
+        }
+    }
+    if (nbVides == 0)
+        return false;
+    choix = hasard() % nbVides;
+    for (char i = 0; i < NB_LIGNE; i++) {
+        for (char j = 0; j < NB_COL; j++) {
+            if (m_tabMines[i][j] == ' ') {
+                if (choix == 0) {
+                    *x = j + 1;
+                    *y = i + 1;
+                    return true;
+                }
+                choix--;
+            }
+        }
+    }
+    return false;
+}
+
+/*
+ * @brief Trouve la premire case vide du champ, dans l'ordre du masque
+ * (ligne par ligne).
+ * @param uint8_t* x, uint8_t* y Reoivent la position (1  20, 1  4) de la case
+ * @return faux s'il n'y a aucune case vide
+ */
+static bool solveur_premiereVide(uint8_t* x, uint8_t* y)
+{
+    for (char i = 0; i < NB_LIGNE; i++) {
+        for (char j = 0; j < NB_COL; j++) {
+            if (m_tabMines[i][j] == ' ') {
+                *x = j + 1;
+                *y = i + 1;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*
+ * @brief Applique les deux rgles de base sur une case dvoile.
+ * @param char ligne, char colonne La case dans m_tabVue
+ * @return vrai si une tuile autour a t dvoile ou marque d'un drapeau
+ */
+static bool solveur_deduit(char ligne, char colonne)
+{
+    char nbTuiles; //nombre de tuiles autour de la case
+    signed char restant = solveur_restant(ligne, colonne, &nbTuiles);
+
+    if (restant < 0 || nbTuiles == 0) //case pas encore connue ou plus rien  dduire autour
+        return false;
+    if (restant == 0) //les mines autour sont toutes trouves
+        solveur_marqueVoisins(ligne, colonne, false);
+    else if (restant == nbTuiles) //toutes les tuiles autour sont des mines
+        solveur_marqueVoisins(ligne, colonne, true);
+    else
+        return false;
+    return true;
+}
+
+/*
+ * @brief Compte les tuiles autour d'une case dvoile et le nombre de mines
+ * qu'il reste  trouver parmi elles.
+ * @param char ligne, char colonne La case dans m_tabVue
+ * @param char* nbTuiles Reoit le nombre de tuiles autour de la case
+ * @return le nombre de mines pas encore marques autour, -1 si la case n'est
+ * pas dvoile
+ */
+static signed char solveur_restant(char ligne, char colonne, char* nbTuiles)
+{
+    char valeur = m_tabVue[ligne][colonne];
+    signed char restant; //mines pas encore marques autour de la case
+    char ligneMax = VOISIN_MAX(ligne, NB_LIGNE);
+    char colonneMax = VOISIN_MAX(colonne, NB_COL); //bornes du 3x3, calcules une seule fois
+
+    *nbTuiles = 0;
+    if (valeur == TUILE || valeur == DRAPEAU)
+        return -1;
+    restant = (valeur == ' ') ? 0 : valeur - '0';
+    for (char i = VOISIN_MIN(ligne); i <= ligneMax; i++) {
+        for (char j = VOISIN_MIN(colonne); j <= colonneMax; j++) {
+            if (m_tabVue[i][j] == TUILE)
+                (*nbTuiles)++;
+            else if (m_tabVue[i][j] == DRAPEAU)
+                restant--;
+        }
+    }
+    return restant;
+}
+
+/*
+ * @brief Rgle des paires: si les tuiles autour d'une case A sont toutes
+ * aussi autour d'une case B voisine, les tuiles de B qui ne touchent pas A
+ * contiennent exactement (restant de B - restant de A) mines. Si ce nombre
+ * vaut 0 elles sont sres, s'il gale leur nombre ce sont toutes des mines.
+ * @param char ligne, char colonne La case A dans m_tabVue
+ * @return vrai si une tuile a t dvoile ou marque d'un drapeau
+ */
+static bool solveur_deduitPaire(char ligne, char colonne)
+{
+    char nbTuilesA, nbTuilesB;
+    signed char restantA = solveur_restant(ligne, colonne, &nbTuilesA);
+    signed char restantB;
+    char nbHorsA; //tuiles autour de B qui ne touchent pas A
+    bool inclus; //vrai si les tuiles de A sont toutes autour de B
+    bool progres = false;
+
+    if (restantA < 0 || nbTuilesA == 0)
+        return false;
+    for (signed char bi = ligne - 2; bi <= ligne + 2; bi++) {
+        for (signed char bj = colonne - 2; bj <= colonne + 2; bj++) {
+            if (bi < 0 || bi >= NB_LIGNE || bj < 0 || bj >= NB_COL || (bi == ligne && bj == colonne))
+                continue;
+            restantB = solveur_restant(bi, bj, &nbTuilesB);
+            if (restantB < 0 || nbTuilesB <= nbTuilesA)
+                continue;
+            inclus = true; //les tuiles de A sont-elles toutes voisines de B?
+            for (signed char i = ligne - 1; i <= ligne + 1; i++) {
+                for (signed char j = colonne - 1; j <= colonne + 1; j++) {
+                    if (i >= 0 && i < NB_LIGNE && j >= 0 && j < NB_COL && m_tabVue[i][j] == TUILE
+                        && (i < bi - 1 || i > bi + 1 || j < bj - 1 || j > bj + 1))
+                        inclus = false;
+                }
+            }
+            if (!inclus)
+                continue;
+            nbHorsA = nbTuilesB - nbTuilesA;
+            if (restantB - restantA != 0 && restantB - restantA != nbHorsA)
+                continue;
+            for (signed char i = bi - 1; i <= bi + 1; i++) { //on traite les tuiles de B hors de A
+                for (signed char j = bj - 1; j <= bj + 1; j++) {
+                    if (i >= 0 && i < NB_LIGNE && j >= 0 && j < NB_COL && m_tabVue[i][j] == TUILE
+                        && (i < ligne - 1 || i > ligne + 1 || j < colonne - 1 || j > colonne + 1)) {
+                        if (restantB == restantA)
+                            solveur_ouvre(i, j);
+                        else {
+                            m_tabVue[i][j] = DRAPEAU;
+                            m_nbDrapeaux++;
+                        }
+                        progres = true;
+                    }
+                }
+            }
+            if (progres)
+                return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * @brief Dvoile les tuiles autour d'une case ou y met des drapeaux.
+ * @param char ligne, char colonne La case au centre du 3x3
+ * @param bool mine vrai pour mettre des drapeaux, faux pour dvoiler
+ * @return rien
+ */
+static void solveur_marqueVoisins(char ligne, char colonne, bool mine)
+{
+    char ligneMax = VOISIN_MAX(ligne, NB_LIGNE);
+    char colonneMax = VOISIN_MAX(colonne, NB_COL);
+
+    for (char i = VOISIN_MIN(ligne); i <= ligneMax; i++) {
+        for (char j = VOISIN_MIN(colonne); j <= colonneMax; j++) {
+            if (m_tabVue[i][j] == TUILE) {
+                if (mine) {
+                    m_tabVue[i][j] = DRAPEAU;
+                    m_nbDrapeaux++;
+                } else
+                    solveur_ouvre(i, j);
+            }
+        }
+    }
+}
+
+/*
+ * @brief Dvoile une case dans m_tabVue comme le ferait le joueur.
+ * @param char ligne, char colonne La case  dvoiler
+ * @return rien
+ */
+static void solveur_ouvre(char ligne, char colonne)
+{
+    m_tabVue[ligne][colonne] = m_tabMines[ligne][colonne];
+    m_nbOuvertes++;
+}
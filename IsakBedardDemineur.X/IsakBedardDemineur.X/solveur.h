@@ -0,0 +1,48 @@
+/**
+ * @file   solveur.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Gnration des champs du mode "sans devinette", valids par un
+ * solveur logique.
+ */
+
+#ifndef SOLVEUR_H
+#define	SOLVEUR_H
+
+#include <stdbool.h>  // pour l'utilisation du type bool
+#include <stdint.h>  // pour les types de taille fixe (uint8_t)
+#include "demineur.h"
+
+extern LOCAL_FIL unsigned char m_nbValidations; //passages du solveur pendant le dernier solveur_genere() ou solveur_verifie()
+
+/**
+ * @brief Gnre un champ de mines (m_tabMines, avec ses chiffres) qui peut
+ * tre rsolu sans jamais deviner, en partant d'une case vide choisie au
+ * hasard. Les champs qui bloquent le solveur sont rpars en dplaant une
+ * mine, ou remplacs si c'est impossible, pour au plus NB_VALIDATIONS
+ * passages du solveur. Utilise m_tabVue comme tableau de travail: il est
+ * laiss dans un tat quelconque au retour.
+ * @param nb Le nombre de mines  placer
+ * @param x, y Reoivent la case de dpart (1  20, 1  4), 0 s'il n'y a
+ * aucune case vide dans le champ
+ * @return vrai si le champ se rsout par la logique seulement, faux si
+ * aucun champ valide n'a t trouv: m_tabMines contient alors le dernier
+ * champ essay
+ */
+bool solveur_genere(uint8_t nb, uint8_t* x, uint8_t* y);
+
+/**
+ * @brief Vrifie qu'un champ dj plac dans m_tabMines (avec ses chiffres)
+ * se rsout sans deviner en partant de sa premire case vide dans l'ordre
+ * du masque (voir masque.h): c'est la case que dvoile la commande 'L'
+ * (commande.h). Un champ qui bloque est rpar comme dans solveur_genere(),
+ * pour au plus NB_VALIDATIONS passages. Utilise m_tabVue comme tableau de
+ * travail. Sert  hote/generation.c, qui valide les champs  charger.
+ * @param nb Le nombre de mines du champ
+ * @return vrai si le champ, rpar au besoin, se rsout par la logique
+ * seulement. Faux s'il n'a aucune case vide ou ne peut pas tre rpar:
+ * m_tabMines contient alors le dernier champ essay
+ */
+bool solveur_verifie(uint8_t nb);
+
+#endif	/* SOLVEUR_H */
@@ -0,0 +1,221 @@
+/**
+ * @file   stats.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Journal des parties dans l'EEPROM de donnes du 18F45K20.
+ *
+ * L'criture d'un octet dans l'EEPROM prend quelques millisecondes. Pour ne
+ * jamais bloquer la boucle principale, les enregistrements termins sont mis
+ * dans une petite file en RAM et crits un octet  la fois: chaque fin
+ * d'criture (interruption EEIF) lance l'criture de l'octet suivant.
+ * Le format des enregistrements est dcrit dans stats.h.
+ */
+
+#include <xc.h>
+#include <conio.h>
+#include "entrees.h"
+#include "veille.h"
+#include "stats.h"
+
+#define TAILLE_ENREG 8 //octets par enregistrement
+#define NB_EMPLACEMENTS 32 //enregistrements dans les 256 octets de l'EEPROM
+#define TAILLE_FILE 4 //enregistrements en attente d'criture
+
+static unsigned char m_file[TAILLE_FILE][TAILLE_ENREG]; //enregistrements en attente d'criture
+static unsigned char m_emplacementFile[TAILLE_FILE]; //emplacement de l'EEPROM de chaque enregistrement en attente
+static volatile unsigned char m_tete = 0; //enregistrement en cours d'criture (modifi par l'interruption)
+static volatile unsigned char m_nbEnAttente = 0; //enregistrements pas encore crits (modifi par l'interruption)
+static volatile unsigned char m_octet = 0; //octet en cours d'criture dans l'enregistrement de tte (modifi par l'interruption)
+
+static unsigned char m_sequence = 0; //numro de squence du prochain enregistrement
+static unsigned char m_prochainEmplacement = 0; //emplacement du prochain enregistrement
+static unsigned char m_nbMines; //nombre de mines de la partie en cours
+static unsigned int m_nbClics; //nombre de clics dans la partie en cours
+static unsigned long m_tickDebut; //tick du dbut de la partie en cours
+
+static unsigned char stats_litOctet(unsigned char adresse);
+static void stats_ecritOctet(void);
+static bool stats_valide(unsigned char noEmplacement);
+
+/*
+ * @brief Retrouve le dernier enregistrement. Voir stats.h.
+ * @param uint8_t defaut Le nombre de mines si l'EEPROM est vide
+ * @return Le nombre de mines de la prochaine partie
+ */
+uint8_t stats_init(uint8_t defaut)
+{
+    unsigned char suivante; //emplacement qui suit l'emplacement vrifi
+    unsigned char adresse;
+
+    for (unsigned char i = 0; i < NB_EMPLACEMENTS; i++) {
+        suivante = (i + 1) % NB_EMPLACEMENTS;
+        if (stats_valide(i) && !(stats_valide(suivante)
+            && stats_litOctet(suivante * TAILLE_ENREG) == (unsigned char) (stats_litOctet(i * TAILLE_ENREG) + 1))) {
+            adresse = i * TAILLE_ENREG; //la squence se brise aprs cet emplacement: c'est la dernire partie
+            m_sequence = stats_litOctet(adresse) + 1;
+            m_prochainEmplacement = suivante;
+            return stats_litOctet(adresse + 2) + stats_litOctet(adresse + 1); //une mine de plus si gagne
+        }
+    }
+    return defaut; //EEPROM vide (ou efface)
+}
+
+/*
+ * @brief Note le dbut d'une partie.
+ * @param uint8_t nbMines Le nombre de mines de la partie
+ * @return rien
+ */
+void stats_debutPartie(uint8_t nbMines)
+{
+    m_nbMines = nbMines;
+    m_nbClics = 0;
+    m_tickDebut = m_noTick;
+}
+
+/*
+ * @brief Compte un clic dans la partie en cours.
+ * @param rien
+ * @return rien
+ */
+void stats_clic(void)
+{
+    m_nbClics++;
+}
+
+/*
+ * @brief Met l'enregistrement de la partie termine dans la file et lance
+ * l'criture si l'EEPROM est libre. Si la file est pleine, l'enregistrement
+ * est perdu plutt que de faire attendre le jeu.
+ * La place libre est choisie les interruptions dsactives: une interruption
+ * EEIF entre la lecture de m_tete et celle de m_nbEnAttente ferait
+ * rcrire le dernier enregistrement de la file. Cette place ne peut ensuite
+ * qu'tre libre par l'interruption, jamais reprise: on la remplit donc
+ * les interruptions actives.
+ * @param bool gagne vrai si la partie a t gagne
+ * @return rien
+ */
+void stats_finPartie(bool gagne)
+{
+    unsigned char fin; //place libre dans la file
+    unsigned int duree = m_noTick - m_tickDebut;
+    unsigned char somme = 0;
+
+    di(); //m_tete et m_nbEnAttente sont modifis par l'interruption EEIF
+    if (m_nbEnAttente == TAILLE_FILE) {
+        ei();
+        return;
+    }
+    fin = (m_tete + m_nbEnAttente) % TAILLE_FILE;
+    ei();
+    m_file[fin][0] = m_sequence++;
+    m_file[fin][1] = gagne;
+    m_file[fin][2] = m_nbMines;
+    m_file[fin][3] = m_nbClics;
+    m_file[fin][4] = m_nbClics >> 8;
+    m_file[fin][5] = duree;
+    m_file[fin][6] = duree >> 8;
+    for (char i = 0; i < TAILLE_ENREG - 1; i++)
+        somme += m_file[fin][i];
+    m_file[fin][7] = ~somme;
+    m_emplacementFile[fin] = m_prochainEmplacement;
+    m_prochainEmplacement = (m_prochainEmplacement + 1) % NB_EMPLACEMENTS;
+
+    di(); //l'interruption EEIF modifie aussi la file
+    m_nbEnAttente++;
+    if (m_nbEnAttente == 1) { //l'EEPROM tait libre: on lance le premier octet
+        m_octet = 0;
+        stats_ecritOctet();
+    }
+    ei();
+}
+
+/*
+ * @brief Fin de l'criture d'un octet: passe  l'octet suivant, puis 
+ * l'enregistrement suivant de la file. Appele par l'interruption.
+ * @param rien
+ * @return rien
+ */
+void stats_interruption(void)
+{
+    PIR2bits.EEIF = 0;
+    m_octet++;
+    if (m_octet == TAILLE_ENREG) { //enregistrement de tte compltement crit
+        m_octet = 0;
+        m_tete = (m_tete + 1) % TAILLE_FILE;
+        m_nbEnAttente--;
+    }
+    if (m_nbEnAttente != 0)
+        stats_ecritOctet();
+    else
+        EECON1bits.WREN = 0; //plus rien  crire
+}
+
+/*
+ * @brief Envoie le contenu de l'EEPROM sur le port srie.
+ * @param rien
+ * @return rien
+ */
+void stats_envoie(void)
+{
+    unsigned char adresse = 0;
+
+    while (m_nbEnAttente != 0) { //pas de lecture pendant une criture
+        di();
+        if (m_nbEnAttente != 0)
+            veille_dort(); //rveill par EEIF
+        ei();
+    }
+    do {
+        putch(stats_litOctet(adresse));
+        adresse++;
+    } while (adresse != 0); //256 octets
+}
+
+/*
+ * @brief Lance l'criture de l'octet courant de l'enregistrement de tte.
+ * Les interruptions doivent tre dsactives (squence 0x55 0xAA).
+ * @param rien
+ * @return rien
+ */
+static void stats_ecritOctet(void)
+{
+    EEADR = m_emplacementFile[m_tete] * TAILLE_ENREG + m_octet;
+    EEDATA = m_file[m_tete][m_octet];
+    EECON1bits.EEPGD = 0; //EEPROM de donnes
+    EECON1bits.CFGS = 0;
+    EECON1bits.WREN = 1;
+    PIE2bits.EEIE = 1; //EEIF lancera l'octet suivant
+    EECON2 = 0x55;
+    EECON2 = 0xAA; //squence obligatoire avant chaque criture
+    EECON1bits.WR = 1;
+}
+
+/*
+ * @brief Lit un octet de l'EEPROM de donnes.
+ * @param unsigned char adresse L'adresse  lire
+ * @return l'octet lu
+ */
+static unsigned char stats_litOctet(unsigned char adresse)
+{
+    EEADR = adresse;
+    EECON1bits.EEPGD = 0; //EEPROM de donnes
+    EECON1bits.CFGS = 0;
+    EECON1bits.RD = 1;
+    return EEDATA;
+}
+
+/*
+ * @brief Vrifie la somme de contrle d'un enregistrement. Un emplacement jamais
+ * crit (0xFF partout) ou une criture interrompue par une coupure
+ * d'alimentation ne passe pas.
+ * @param unsigned char noEmplacement L'emplacement  vrifier
+ * @return vrai si l'enregistrement est valide
+ */
+static bool stats_valide(unsigned char noEmplacement)
+{
+    unsigned char somme = 0;
+
+    for (char i = 0; i < TAILLE_ENREG; i++)
+        somme += stats_litOctet(noEmplacement * TAILLE_ENREG + i);
+    return somme == 0xFF; //somme des octets 0  6 + son complment
+}
@@ -0,0 +1,64 @@
+/**
+ * @file   stats.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Statistiques des parties conserves dans l'EEPROM de donnes.
+ *
+ * Chaque partie termine ajoute un enregistrement de 8 octets:
+ *  0: numro de squence (augmente de 1  chaque partie, modulo 256)
+ *  1: rsultat (1 = gagn, 0 = perdu)
+ *  2: nombre de mines
+ *  3-4: nombre de clics (octet de poids faible d'abord)
+ *  5-6: dure en ticks de 100 ms (octet de poids faible d'abord)
+ *  7: somme de contrle (complment de la somme des octets 0  6)
+ * Les 32 enregistrements de l'EEPROM (256 octets) sont crits en rond pour
+ * rpartir l'usure. Le dernier est celui aprs lequel la squence se brise.
+ */
+
+#ifndef STATS_H
+#define	STATS_H
+
+#include <stdbool.h>  // pour l'utilisation du type bool
+#include <stdint.h>  // pour les types de taille fixe (uint8_t)
+
+/**
+ * @brief Retrouve le dernier enregistrement et prpare l'criture du
+ * suivant.  appeler une fois au dmarrage, avant d'activer les interruptions.
+ * @param defaut Nombre de mines  utiliser si l'EEPROM est vide
+ * @return Le nombre de mines de la prochaine partie: celui de la dernire
+ * partie enregistre, plus 1 si elle a t gagne
+ */
+uint8_t stats_init(uint8_t defaut);
+
+/**
+ * @brief Note le dbut d'une partie.
+ * @param nbMines Le nombre de mines de la partie
+ */
+void stats_debutPartie(uint8_t nbMines);
+
+/**
+ * @brief Compte un clic (bouton du joystick) dans la partie en cours.
+ */
+void stats_clic(void);
+
+/**
+ * @brief Termine la partie et met son enregistrement en file d'criture.
+ * Ne fait que copier 8 octets: l'criture se fait en arrire-plan, un octet
+ * par interruption EEIF.
+ * @param gagne vrai si la partie a t gagne
+ */
+void stats_finPartie(bool gagne);
+
+/**
+ * @brief Traitement de l'interruption EEIF (fin d'criture d'un octet).
+ * Lance l'criture de l'octet suivant s'il y en a un.
+ */
+void stats_interruption(void);
+
+/**
+ * @brief Envoie le contenu de l'EEPROM (256 octets) sur le port srie, aprs
+ * avoir attendu la fin des critures en cours.
+ */
+void stats_envoie(void);
+
+#endif	/* STATS_H */
@@ -0,0 +1,144 @@
+/**
+ * @file   veille.c
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Horloge des ticks (Timer2) et mise en veille IDLE. Voir veille.h.
+ *
+ * Le Timer2 compte  Fosc/16 (prdiviseur 1:4), priode de 250 coups et
+ * postdiviseur 1:5: une interruption toutes les 20 ms, sans drive puisque
+ * le Timer2 se recharge lui-mme. Le SLEEP profond arrterait aussi le
+ * Timer2 et l'EUSART; on utilise donc le mode IDLE.
+ */
+
+#include <xc.h>
+#include <stdbool.h>  // pour l'utilisation du type bool
+#include "serie.h"
+#include "veille.h"
+
+#define PERIODE_TIMER2 249 //PR2: 250 coups de 16 us = 4 ms
+#define INTERRUPTIONS_PAR_TICK 5 //5 x 20 ms = 100 ms
+#define MS_PAR_INTERRUPTION 20
+#define CYCLES_PAR_MS 250 //Fosc/4 = 250 kHz
+
+static volatile bool m_finTick = false; //mis  vrai par l'interruption  la fin de chaque tick
+static volatile unsigned char m_nbInterruptions = 0; //interruptions depuis le dernier tick
+static volatile unsigned long m_dureeMs = 0; //temps coul depuis le dmarrage de l'horloge
+static unsigned long m_veilleMs = 0; //temps pass en veille
+static unsigned int m_veilleCycles = 0; //reste de m_veilleMs, moins d'une ms
+static volatile unsigned int m_nbDebordements = 0; //16 bits de poids fort de veille_cycles()
+
+/*
+ * @brief Configure le Timer2 et le mode IDLE. Voir veille.h.
+ * @param rien
+ * @return rien
+ */
+void veille_init(void)
+{
+    PR2 = PERIODE_TIMER2;
+    T2CONbits.T2CKPS = 1; //prdiviseur 1:4
+    T2CONbits.TOUTPS = 4; //postdiviseur 1:5
+    T2CONbits.TMR2ON = 1;
+    PIE1bits.TMR2IE = 1;
+    PIE1bits.TMR1IE = 1; //prolonge le Timer1  32 bits
+    OSCCONbits.IDLEN = 1; //SLEEP() arrte seulement le CPU
+}
+
+/*
+ * @brief Compte les interruptions du Timer2 et marque la fin des ticks.
+ * @param rien
+ * @return rien
+ */
+void veille_interruption(void)
+{
+    PIR1bits.TMR2IF = 0;
+    m_dureeMs += MS_PAR_INTERRUPTION;
+    m_nbInterruptions++;
+    if (m_nbInterruptions == INTERRUPTIONS_PAR_TICK) {
+        m_nbInterruptions = 0;
+        m_finTick = true;
+    }
+}
+
+/*
+ * @brief Compte un dbordement du Timer1.
+ * @param rien
+ * @return rien
+ */
+void veille_debordement(void)
+{
+    PIR1bits.TMR1IF = 0;
+    m_nbDebordements++;
+}
+
+/*
+ * @brief Lit l'horloge de 32 bits. Voir veille.h.
+ * @param rien
+ * @return le nombre de cycles depuis le reset
+ */
+unsigned long veille_cycles(void)
+{
+    unsigned int bas;
+    unsigned int haut;
+
+    di();
+    bas = TMR1;
+    haut = m_nbDebordements;
+    if (PIR1bits.TMR1IF && bas < 0x8000) //dbordement arriv juste avant la lecture, pas encore compt
+        haut++;
+    ei();
+    return ((unsigned long) haut << 16) | bas;
+}
+
+/*
+ * @brief Dort jusqu' la fin du tick courant. Si le tick est dj fini (le
+ * traitement a t plus long que 100 ms), retourne tout de suite.
+ * @param rien
+ * @return rien
+ */
+void veille_attendTick(void)
+{
+    while (!m_finTick) {
+        di();
+        if (!m_finTick)
+            veille_dort();
+        ei();
+    }
+    m_finTick = false;
+}
+
+/*
+ * @brief Met le CPU en veille et compte le temps pass. Voir veille.h.
+ * @param rien
+ * @return rien
+ */
+void veille_dort(void)
+{
+    unsigned int debut = TMR1; //le Timer1 continue en IDLE
+
+    SLEEP();
+    NOP(); //l'instruction qui suit SLEEP est excute au rveil
+    m_veilleCycles += TMR1 - debut; //au plus 20 ms = 5000 cycles
+    m_veilleMs += m_veilleCycles / CYCLES_PAR_MS;
+    m_veilleCycles %= CYCLES_PAR_MS;
+}
+
+/*
+ * @brief Envoie les dures en JSON. Voir veille.h.
+ * @param rien
+ * @return rien
+ */
+void veille_envoie(void)
+{
+    unsigned long duree;
+
+    di(); //m_dureeMs est modifi par l'interruption
+    duree = m_dureeMs;
+    ei();
+    serie_envoieTexte("{\"duree_ms\":");
+    serie_envoieNombre(duree);
+    serie_envoieTexte(",\"veille_ms\":");
+    serie_envoieNombre(m_veilleMs);
+    serie_envoieTexte(",\"actif_ms\":");
+    serie_envoieNombre(duree > m_veilleMs ? duree - m_veilleMs : 0);
+    serie_envoieTexte("}\r\n");
+}
@@ -0,0 +1,66 @@
+/**
+ * @file   veille.h
+ * @author Isak Bdard
+ * @date   28 novembre 2019
+ * @brief  Horloge des ticks et mise en veille du CPU entre les traitements.
+ *
+ * Le Timer2 interrompt toutes les 20 ms et marque la fin d'un tick de
+ * 100 ms toutes les 5 interruptions. Entre deux interruptions, le CPU est mis
+ * en mode IDLE: il s'arrte, mais les priphriques (Timer1, Timer2, EUSART,
+ * EEPROM) continuent et leurs interruptions le rveillent.
+ *
+ * Le Timer1 (1 cycle d'instruction par coup) est prolong  32 bits par son
+ * interruption de dbordement: veille_cycles() sert d'horloge aux mesures.
+ *
+ * Le temps pass en veille est mesur avec le Timer1 et envoy par la
+ * commande 'W' (voir commande.h), en une ligne JSON:
+ *  {"duree_ms":..,"veille_ms":..,"actif_ms":..}
+ * o duree_ms est le temps coul depuis le dmarrage de l'horloge.
+ */
+
+#ifndef VEILLE_H
+#define	VEILLE_H
+
+/**
+ * @brief Configure le Timer2 et le mode IDLE. Les ticks commencent ds que
+ * les interruptions sont actives.
+ */
+void veille_init(void);
+
+/**
+ * @brief Traitement de l'interruption TMR2IF.
+ */
+void veille_interruption(void);
+
+/**
+ * @brief Traitement de l'interruption TMR1IF (dbordement du Timer1).
+ */
+void veille_debordement(void);
+
+/**
+ * @brief Lit l'horloge de 32 bits. Repasse  0 aprs 4,7 heures: les
+ * diffrences entre deux lectures restent justes jusqu' cette dure.
+ * @return Le nombre de cycles d'instruction (4 us) depuis le reset
+ */
+unsigned long veille_cycles(void);
+
+/**
+ * @brief Attend en veille la fin du tick courant.
+ */
+void veille_attendTick(void);
+
+/**
+ * @brief Met le CPU en veille jusqu' la prochaine interruption, au plus 20 ms.
+ *  appeler entre di() et ei(), juste aprs avoir vrifi qu'il n'y a rien 
+ * faire: une interruption arrive aprs la vrification rveille quand mme
+ * le CPU et n'est traite qu'au ei() qui suit. Ex:
+ *   di(); if (rien  faire) veille_dort(); ei();
+ */
+void veille_dort(void);
+
+/**
+ * @brief Envoie le temps actif et le temps en veille sur le port srie.
+ */
+void veille_envoie(void);
+
+#endif	/* VEILLE_H */